@@ -66,6 +66,8 @@ def translate_input(user_dict):
 def write_mpi(user_dict):
     mpi_dict = {
         "numerically_exact": user_dict["MPI"]["numerically_exact"],
+        "reduce_by_nodes": user_dict["MPI"]["reduce_by_nodes"],
+        "omp_orbital_nodes": user_dict["MPI"]["omp_orbital_nodes"],
         "shared_memory_size": user_dict["MPI"]["shared_memory_size"],
         "bank_size": user_dict["MPI"]["bank_size"],
         "omp_threads": user_dict["MPI"]["omp_threads"],
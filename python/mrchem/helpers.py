@@ -59,6 +59,8 @@ def write_scf_fock(user_dict, wf_dict, origin):
             "include_nuclear": user_dict["ZORA"]["include_nuclear"],
             "include_coulomb": user_dict["ZORA"]["include_coulomb"],
             "include_xc": user_dict["ZORA"]["include_xc"],
+            "rebuild_thrs": user_dict["ZORA"]["rebuild_thrs"],
+            "freeze_iteration": user_dict["ZORA"]["freeze_iteration"],
             "isAZORA": False,
             "azora_potential_path": user_dict["ZORA"]["azora_potential_path"]
         }
@@ -93,6 +95,8 @@ def write_scf_fock(user_dict, wf_dict, origin):
         fock_dict["coulomb_operator"] = {
             "poisson_prec": user_dict["Precisions"]["poisson_prec"],
             "shared_memory": user_dict["MPI"]["share_coulomb_potential"],
+            "include_nuclear": user_dict["WaveFunction"]["combined_electrostatics"],
+            "nuclear_exponent": user_dict["WaveFunction"]["combined_electrostatics_exponent"],
         }
 
     # Exchange
@@ -174,6 +178,9 @@ def _reaction_operator_handler(user_dict, rsp=False):
             "solver_type": "Poisson-Boltzmann"
             if ionic_model == "pb"
             else "Linearized_Poisson-Boltzmann",
+            "newton": user_dict["PCM"]["SCRF"]["pb_newton"],
+            "newton_micro_iter": user_dict["PCM"]["SCRF"]["pb_newton_micro_iter"],
+            "newton_eta": user_dict["PCM"]["SCRF"]["pb_newton_eta"],
         }
 
     return reo_dict
@@ -235,6 +242,7 @@ def write_scf_guess(user_dict, wf_dict):
         "environment": wf_dict["environment_name"],
         "external_field": wf_dict["external_name"],
         "screen": scf_dict["guess_screen"],
+        "cube_tricubic": scf_dict["guess_cube_tricubic"],
         "localize": scf_dict["localize"],
         "rotate": scf_dict["guess_rotate"],
         "restricted": user_dict["WaveFunction"]["restricted"],
@@ -278,12 +286,31 @@ def write_scf_solver(user_dict, wf_dict):
         "final_prec": final_prec,
         "energy_thrs": scf_dict["energy_thrs"],
         "orbital_thrs": scf_dict["orbital_thrs"],
+        "lock_thrs": scf_dict["lock_thrs"],
+        "lock_iterations": scf_dict["lock_iterations"],
         "helmholtz_prec": user_dict["Precisions"]["helmholtz_prec"],
     }
+    multilevel = write_multilevel(user_dict, final_prec)
+    if multilevel:
+        solver_dict["multilevel"] = multilevel
 
     return solver_dict
 
 
+def write_multilevel(user_dict, final_prec):
+    # Low order first stage of the SCF and response optimizations
+    order = user_dict["Basis"]["multilevel_order"]
+    if order < 1:
+        return {}
+    prec = user_dict["Basis"]["multilevel_prec"]
+    if prec < 0.0:
+        # Inverse of the automatic polynomial order in write_mra
+        prec = 10.0 ** (-order / 1.5)
+    if prec <= final_prec:
+        return {}
+    return {"order": order, "prec": prec}
+
+
 def write_scf_properties(user_dict, origin):
     prop_dict = {}
     if user_dict["Properties"]["dipole_moment"]:
@@ -496,6 +523,9 @@ def write_rsp_solver(user_dict, wf_dict, d):
         "helmholtz_prec": user_dict["Precisions"]["helmholtz_prec"],
         "orth_prec": 1.0e-14,
     }
+    multilevel = write_multilevel(user_dict, final_prec)
+    if multilevel:
+        solver_dict["multilevel"] = multilevel
     return solver_dict
 
 
@@ -213,6 +213,12 @@ def stencil() -> JSONDict:
                     {   'keywords': [   {   'default': False,
                                             'name': 'numerically_exact',
                                             'type': 'bool'},
+                                        {   'default': False,
+                                            'name': 'reduce_by_nodes',
+                                            'type': 'bool'},
+                                        {   'default': 0,
+                                            'name': 'omp_orbital_nodes',
+                                            'type': 'int'},
                                         {   'default': 10000,
                                             'name': 'shared_memory_size',
                                             'type': 'int'},
@@ -241,7 +247,13 @@ def stencil() -> JSONDict:
                                                               'in '
                                                               "['interpolating', "
                                                               "'legendre']"],
-                                            'type': 'str'}],
+                                            'type': 'str'},
+                                        {   'default': -1,
+                                            'name': 'multilevel_order',
+                                            'type': 'int'},
+                                        {   'default': -1.0,
+                                            'name': 'multilevel_prec',
+                                            'type': 'float'}],
                         'name': 'Basis'},
                     {   'keywords': [   {   'default': 'abgv_55',
                                             'name': 'kinetic',
@@ -317,7 +329,13 @@ def stencil() -> JSONDict:
                                                               "'point_minimal', "
                                                               "'finite_gaussian', "
                                                               "'finite_sphere']"],
-                                            'type': 'str'}],
+                                            'type': 'str'},
+                                        {   'default': False,
+                                            'name': 'combined_electrostatics',
+                                            'type': 'bool'},
+                                        {   'default': 100.0,
+                                            'name': 'combined_electrostatics_exponent',
+                                            'type': 'float'}],
                         'name': 'WaveFunction'},
                     {   'keywords': [   {   'default': True,
                                             'name': 'include_nuclear',
@@ -328,6 +346,12 @@ def stencil() -> JSONDict:
                                         {   'default': True,
                                             'name': 'include_xc',
                                             'type': 'bool'},
+                                        {   'default': -1.0,
+                                            'name': 'rebuild_thrs',
+                                            'type': 'float'},
+                                        {   'default': -1,
+                                            'name': 'freeze_iteration',
+                                            'type': 'int'},
                                         {   'default': 'none',
                                             'name': 'azora_potential_path',
                                             'type': 'str'}],
@@ -494,6 +518,12 @@ def stencil() -> JSONDict:
                                         {   'default': -1.0,
                                             'name': 'energy_thrs',
                                             'type': 'float'},
+                                        {   'default': -1.0,
+                                            'name': 'lock_thrs',
+                                            'type': 'float'},
+                                        {   'default': 3,
+                                            'name': 'lock_iterations',
+                                            'type': 'int'},
                                         {   'default': 0.001,
                                             'name': 'guess_prec',
                                             'predicates': [   '1.0e-10 < value '
@@ -502,6 +532,9 @@ def stencil() -> JSONDict:
                                         {   'default': 12.0,
                                             'name': 'guess_screen',
                                             'type': 'float'},
+                                        {   'default': False,
+                                            'name': 'guess_cube_tricubic',
+                                            'type': 'bool'},
                                         {   'default': -1.0,
                                             'name': 'start_prec',
                                             'type': 'float'},
@@ -613,6 +646,15 @@ def stencil() -> JSONDict:
                                                                                   "'nuclear', "
                                                                                   "'electronic']"],
                                                                 'type': 'str'},
+                                                            {   'default': False,
+                                                                'name': 'pb_newton',
+                                                                'type': 'bool'},
+                                                            {   'default': 5,
+                                                                'name': 'pb_newton_micro_iter',
+                                                                'type': 'int'},
+                                                            {   'default': 0.1,
+                                                                'name': 'pb_newton_eta',
+                                                                'type': 'float'},
                                                             {   'default': "user['SCF']['kain']",
                                                                 'name': 'kain',
                                                                 'type': 'int'}],
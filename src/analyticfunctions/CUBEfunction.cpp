@@ -25,6 +25,7 @@
 
 #include "CUBEfunction.h"
 
+#include <algorithm>
 #include <cmath>
 #include <fstream>
 #include <iostream>
@@ -44,18 +45,36 @@ CUBEfunction::CUBEfunction(const int N_atoms,
                            std::vector<int> Z_n,
                            std::vector<double> cube,
                            std::vector<double> atom_charges,
-                           std::vector<mrcpp::Coord<3>> atom_coords)
+                           std::vector<mrcpp::Coord<3>> atom_coords,
+                           bool tricubic)
         : N_atoms(N_atoms)
         , N_val(N_vals)
         , N_steps(N_steps)
         , corner(origin)
         , voxel_axes(Voxel_axes)
         , atom_numbers(Z_n)
-        , CUBE(cube)
+        , CUBE(std::make_shared<const std::vector<double>>(std::move(cube)))
         , atom_charges(atom_charges)
-        , atom_coords(atom_coords) {
+        , atom_coords(atom_coords)
+        , tricubic(tricubic) {
     Eigen::Map<const Eigen::Matrix<double, 3, 3, Eigen::RowMajor>> voxel_axes(&Voxel_axes[0][0]);
     inv_basis = voxel_axes.transpose().inverse();
+
+    // Bounding box spanned by the eight corners of the grid
+    box_min = origin;
+    box_max = origin;
+    for (int n = 1; n < 8; n++) {
+        mrcpp::Coord<3> r = origin;
+        for (int i = 0; i < 3; i++) {
+            if ((n >> i) & 1) {
+                for (int d = 0; d < 3; d++) r[d] += (N_steps[i] - 1.0) * Voxel_axes[i][d];
+            }
+        }
+        for (int d = 0; d < 3; d++) {
+            box_min[d] = std::min(box_min[d], r[d]);
+            box_max[d] = std::max(box_max[d], r[d]);
+        }
+    }
 }
 
 // Do a quadrature of the file
@@ -71,56 +90,126 @@ double CUBEfunction::evalf(const mrcpp::Coord<3> &r) const {
      * I then use these d_i, d_j and d_k coefficients as parameters in a trilinear interpolation.
      **/
 
-    double c;
+    // Cheap rejection of points outside the grid, before any other work
+    for (int d = 0; d < 3; d++) {
+        if (r[d] < box_min[d] or r[d] > box_max[d]) return 0.0;
+    }
+
     // perform NX_j \cdot r to find the indices i, j and k of the cubefile.
-    Eigen::Map<const Eigen::Vector3d> r_vec(&r[0]);
-    Eigen::Map<const Eigen::Vector3d> origin(&corner[0]);
-    Eigen::Vector3d coeff = ((inv_basis * (r_vec - origin))); // coefficients i, j and k in r = i*X + j*Y + k*Z assuming basis is orthogonal
+    double dr[3] = {r[0] - corner[0], r[1] - corner[1], r[2] - corner[2]};
+    double coeff[3]; // coefficients i, j and k in r = i*X + j*Y + k*Z assuming basis is orthogonal
+    int idx[3];
+    for (int i = 0; i < 3; i++) {
+        coeff[i] = inv_basis(i, 0) * dr[0] + inv_basis(i, 1) * dr[1] + inv_basis(i, 2) * dr[2];
+        // the point must be strictly inside the grid, otherwise return 0.
+        if (coeff[i] <= 0.0 or coeff[i] >= N_steps[i] - 1.0) return 0.0;
+        idx[i] = static_cast<int>(coeff[i]);
+        coeff[i] -= idx[i];
+    }
+
+    // Tricubic needs at least four grid points along each axis
+    bool cubic = tricubic;
+    for (int i = 0; i < 3; i++) cubic &= (N_steps[i] >= 4);
+
+    if (cubic) return evalTricubic(coeff, idx);
+    return evalTrilinear(coeff, idx);
+}
 
+/** @brief Trilinear interpolation in the voxel starting at grid point idx
+ *
+ * @param coeff: fractional position within the voxel along each voxel axis
+ * @param idx: grid indices of the lower voxel corner
+ */
+double CUBEfunction::evalTrilinear(const double *coeff, const int *idx) const {
     // do the trilinear interpolation naively without loops or any logic (just plug in the equations)
-    // Do a sanity check on the point we are evaluating at is in the cube or not. If not return 0.
-    // this should be potentially done before any operations, to save time
-    std::vector<double> on_edge;
-    std::transform(coeff.cbegin(), coeff.cend(), N_steps.cbegin(), std::back_inserter(on_edge), [](const auto &ci, const auto &Ni) {
-        double di = ci - (Ni - 1.0);
-        return ((di <= -1.0 * (Ni - 1.0)) || (di >= 0.0));
-    });
-
-    if (std::any_of(on_edge.cbegin(), on_edge.cend(), [](const auto &ci) { return ci; })) {
-        c = 0.0;
-    } else {
-
-        auto idx0 = std::floor(coeff(0));
-        auto idx1 = std::floor(coeff(1));
-        auto idx2 = std::floor(coeff(2));
-
-        auto d_idx0 = coeff(0) - idx0;
-        auto d_idx1 = coeff(1) - idx1;
-        auto d_idx2 = coeff(2) - idx2;
-
-        auto N_steps1 = N_steps.at(1);
-        auto N_steps2 = N_steps.at(2);
-
-        auto c000 = CUBE[(idx0)*N_steps1 * N_steps2 + (idx1)*N_steps2 + (idx2)];
-        auto c001 = CUBE[(idx0)*N_steps1 * N_steps2 + (idx1)*N_steps2 + (1 + idx2)];
-        auto c010 = CUBE[(idx0)*N_steps1 * N_steps2 + (1 + idx1) * N_steps2 + (idx2)];
-        auto c011 = CUBE[(idx0)*N_steps1 * N_steps2 + (1 + idx1) * N_steps2 + (1 + idx2)];
-        auto c100 = CUBE[(1 + idx0) * N_steps1 * N_steps2 + (idx1)*N_steps2 + (idx2)];
-        auto c101 = CUBE[(1 + idx0) * N_steps1 * N_steps2 + (idx1)*N_steps2 + (1 + idx2)];
-        auto c110 = CUBE[(1 + idx0) * N_steps1 * N_steps2 + (1 + idx1) * N_steps2 + (idx2)];
-        auto c111 = CUBE[(1 + idx0) * N_steps1 * N_steps2 + (1 + idx1) * N_steps2 + (1 + idx2)];
-
-        auto c00 = c000 * (1 - d_idx0) + c100 * d_idx0;
-        auto c01 = c001 * (1 - d_idx0) + c101 * d_idx0;
-        auto c10 = c010 * (1 - d_idx0) + c110 * d_idx0;
-        auto c11 = c011 * (1 - d_idx0) + c111 * d_idx0;
-
-        auto c0 = c00 * (1 - d_idx1) + c10 * d_idx1;
-        auto c1 = c01 * (1 - d_idx1) + c11 * d_idx1;
-
-        c = c0 * (1 - d_idx2) + c1 * d_idx2;
+    const double *data = CUBE->data();
+    const int s0 = N_steps[1] * N_steps[2];
+    const int s1 = N_steps[2];
+    const int i000 = idx[0] * s0 + idx[1] * s1 + idx[2];
+
+    auto d_idx0 = coeff[0];
+    auto d_idx1 = coeff[1];
+    auto d_idx2 = coeff[2];
+
+    auto c000 = data[i000];
+    auto c001 = data[i000 + 1];
+    auto c010 = data[i000 + s1];
+    auto c011 = data[i000 + s1 + 1];
+    auto c100 = data[i000 + s0];
+    auto c101 = data[i000 + s0 + 1];
+    auto c110 = data[i000 + s0 + s1];
+    auto c111 = data[i000 + s0 + s1 + 1];
+
+    auto c00 = c000 * (1 - d_idx0) + c100 * d_idx0;
+    auto c01 = c001 * (1 - d_idx0) + c101 * d_idx0;
+    auto c10 = c010 * (1 - d_idx0) + c110 * d_idx0;
+    auto c11 = c011 * (1 - d_idx0) + c111 * d_idx0;
+
+    auto c0 = c00 * (1 - d_idx1) + c10 * d_idx1;
+    auto c1 = c01 * (1 - d_idx1) + c11 * d_idx1;
+
+    return c0 * (1 - d_idx2) + c1 * d_idx2;
+}
+
+/** @brief Tricubic interpolation in the voxel starting at grid point idx
+ *
+ * @param coeff: fractional position within the voxel along each voxel axis
+ * @param idx: grid indices of the lower voxel corner
+ *
+ * Separable Catmull-Rom interpolation on the surrounding 4x4x4 grid points.
+ * In the voxels along the edges of the grid the missing outer point is
+ * replaced by a linear extrapolation of the two edge points, which gives a
+ * one-sided tangent at the edge. The interpolant is then continuously
+ * differentiable everywhere in the grid, which makes the projected function
+ * converge with fewer refinement levels than the piecewise trilinear one.
+ */
+double CUBEfunction::evalTricubic(const double *coeff, const int *idx) const {
+    double w[3][4];
+    int start[3];
+    for (int i = 0; i < 3; i++) {
+        const double t = coeff[i];
+        double w0 = 0.5 * ((-t + 2.0) * t - 1.0) * t;
+        double w1 = 0.5 * ((3.0 * t - 5.0) * t * t + 2.0);
+        double w2 = 0.5 * ((-3.0 * t + 4.0) * t + 1.0) * t;
+        double w3 = 0.5 * (t - 1.0) * t * t;
+        if (idx[i] == 0) {
+            // ghost point -1 = 2 * p(0) - p(1)
+            start[i] = 0;
+            w[i][0] = w1 + 2.0 * w0;
+            w[i][1] = w2 - w0;
+            w[i][2] = w3;
+            w[i][3] = 0.0;
+        } else if (idx[i] == N_steps[i] - 2) {
+            // ghost point N = 2 * p(N - 1) - p(N - 2)
+            start[i] = idx[i] - 2;
+            w[i][0] = 0.0;
+            w[i][1] = w0;
+            w[i][2] = w1 - w3;
+            w[i][3] = w2 + 2.0 * w3;
+        } else {
+            start[i] = idx[i] - 1;
+            w[i][0] = w0;
+            w[i][1] = w1;
+            w[i][2] = w2;
+            w[i][3] = w3;
+        }
     }
 
+    const double *data = CUBE->data();
+    const int s0 = N_steps[1] * N_steps[2];
+    const int s1 = N_steps[2];
+    const int first = start[0] * s0 + start[1] * s1 + start[2];
+
+    double c = 0.0;
+    for (int a = 0; a < 4; a++) {
+        double c_a = 0.0;
+        for (int b = 0; b < 4; b++) {
+            const double *row = data + first + a * s0 + b * s1;
+            double c_b = w[2][0] * row[0] + w[2][1] * row[1] + w[2][2] * row[2] + w[2][3] * row[3];
+            c_a += w[1][b] * c_b;
+        }
+        c += w[0][a] * c_a;
+    }
     return c;
 }
 
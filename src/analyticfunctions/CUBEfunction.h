@@ -24,6 +24,9 @@
  */
 
 #pragma once
+
+#include <memory>
+
 #include <MRCPP/MWFunctions>
 
 namespace mrchem {
@@ -38,7 +41,8 @@ public:
                  std::vector<int> Z_n,
                  std::vector<double> cube,
                  std::vector<double> atom_charges,
-                 std::vector<mrcpp::Coord<3>> atom_coords);
+                 std::vector<mrcpp::Coord<3>> atom_coords,
+                 bool tricubic = false);
     double evalf(const mrcpp::Coord<3> &r) const override;
 
 protected:
@@ -48,10 +52,16 @@ protected:
     mrcpp::Coord<3> corner;
     std::array<mrcpp::Coord<3>, 3> voxel_axes; // size 3x3 matrix of the voxel axes, first index denotes which voxel, second denotes stepsize on each cartesian coordinate
     std::vector<int> atom_numbers;
-    std::vector<double> CUBE; // indexing here works as  [x_step*N_steps[1]*N_steps[2] + y_step*N_steps[2] + z_step].
+    std::shared_ptr<const std::vector<double>> CUBE; // indexing here works as  [x_step*N_steps[1]*N_steps[2] + y_step*N_steps[2] + z_step]. Shared between copies.
     std::vector<double> atom_charges;
     std::vector<mrcpp::Coord<3>> atom_coords;
 
+    bool tricubic;            // use tricubic (Catmull-Rom) instead of trilinear interpolation
+    mrcpp::Coord<3> box_min;  // cartesian bounding box of the grid, points outside are zero
+    mrcpp::Coord<3> box_max;
     Eigen::Matrix3d inv_basis; // multiply each row by its 1/norm^2
+
+    double evalTrilinear(const double *coeff, const int *idx) const;
+    double evalTricubic(const double *coeff, const int *idx) const;
 };
 } // namespace mrchem
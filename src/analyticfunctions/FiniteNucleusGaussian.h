@@ -35,18 +35,6 @@ class FiniteNucleusGaussian : public NuclearFunction {
 public:
     FiniteNucleusGaussian() = default;
 
-    double evalf(const mrcpp::Coord<3> &r) const override {
-        double result = 0.0;
-        for (int i = 0; i < this->nuclei.size(); i++) {
-            const auto &R = this->nuclei[i].getCoord();
-            auto R1 = math_utils::calc_distance(r, R);
-            auto Z = this->nuclei[i].getCharge();
-            auto xi = this->param2[i];
-            result += -(Z / R1) * std::erf(std::sqrt(xi) * R1);
-        }
-        return result;
-    }
-
     std::string getParamName1() const { return "RMS"; }
     std::string getParamName2() const { return "Xi"; }
     double calcParam1(double prec, const Nucleus &nuc) const { return nuc.getRMSRadius(); }
@@ -57,6 +45,15 @@ public:
         return xi;
     }
 
+protected:
+    double evalNucleus(int i, double R1) const override {
+        auto Z = this->charges[i];
+        auto xi = this->param2[i];
+        return -(Z / R1) * std::erf(std::sqrt(xi) * R1);
+    }
+
+    // erf(6) = 1 to machine precision
+    double calcShortRange(int i) const override { return 6.0 / std::sqrt(this->param2[i]); }
 };
 
 } // namespace mrchem
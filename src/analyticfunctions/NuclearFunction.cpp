@@ -81,6 +81,37 @@ void NuclearFunction::push_back(const Nucleus &nuc, double p1, double p2) {
     this->nuclei.push_back(nuc);
     this->param1.push_back(p1);
     this->param2.push_back(p2);
+
+    const auto &R = nuc.getCoord();
+    this->charges.push_back(nuc.getCharge());
+    this->coords.insert(this->coords.end(), R.begin(), R.end());
+    this->short_range.push_back(calcShortRange(this->nuclei.size() - 1));
+}
+
+/** @brief Sort the nuclei into a cell list
+ *
+ * Must be called after the last push_back(). Without it, all nuclei are
+ * visited in isZeroOnInterval().
+ */
+void NuclearFunction::setupScreening() {
+    this->nucList = CellList(this->nuclei, 4.0);
+}
+
+double NuclearFunction::evalf(const mrcpp::Coord<3> &r) const {
+    double result = 0.0;
+    const double *R = this->coords.data();
+    for (int i = 0; i < this->charges.size(); i++, R += 3) {
+        double x = r[0] - R[0];
+        double y = r[1] - R[1];
+        double z = r[2] - R[2];
+        double R1 = std::sqrt(x * x + y * y + z * z);
+        if (R1 < this->short_range[i]) {
+            result += evalNucleus(i, R1);
+        } else {
+            result -= this->charges[i] / R1;
+        }
+    }
+    return result;
 }
 
 bool NuclearFunction::isVisibleAtScale(int scale, int nQuadPts) const {
@@ -90,16 +121,29 @@ bool NuclearFunction::isVisibleAtScale(int scale, int nQuadPts) const {
 }
 
 bool NuclearFunction::isZeroOnInterval(const double *a, const double *b) const {
-    int totSplit = 0;
-    for (int i = 0; i < this->nuclei.size(); i++) {
-        const mrcpp::Coord<3> &R = this->nuclei[i].getCoord();
-        int split = 1;
-        if (a[0] > R[0] or b[0] < R[0]) split = 0;
-        if (a[1] > R[1] or b[1] < R[1]) split = 0;
-        if (a[2] > R[2] or b[2] < R[2]) split = 0;
-        totSplit += split;
+    auto contains = [a, b](const mrcpp::Coord<3> &R) {
+        if (a[0] > R[0] or b[0] < R[0]) return false;
+        if (a[1] > R[1] or b[1] < R[1]) return false;
+        if (a[2] > R[2] or b[2] < R[2]) return false;
+        return true;
+    };
+
+    if (this->nucList.size() != this->nuclei.size()) {
+        for (int i = 0; i < this->nuclei.size(); i++) {
+            if (contains(this->nuclei[i].getCoord())) return false;
+        }
+        return true;
+    }
+
+    mrcpp::Coord<3> center;
+    double radius = 0.0;
+    for (int d = 0; d < 3; d++) {
+        center[d] = 0.5 * (a[d] + b[d]);
+        radius = std::max(radius, 0.5 * (b[d] - a[d]));
     }
-    return (totSplit == 0);
+    bool found = false;
+    this->nucList.forEachCandidate(center, radius, [&](int i) { found = found or contains(this->nucList.getCoord(i)); });
+    return not found;
 }
 
 } // namespace mrchem
@@ -30,20 +30,33 @@
 
 #include <MRCPP/MWFunctions>
 
+#include "chemistry/CellList.h"
 #include "chemistry/Nucleus.h"
 
 namespace mrchem {
 
+/** @class NuclearFunction
+ *
+ * @brief Sum of smoothed nuclear potentials
+ *
+ * Each nuclear model only deviates from the plain Coulomb potential -Z/r within a
+ * short range of its nucleus. Beyond this range the potential is evaluated as the
+ * plain Coulomb tail, so the expensive model expression is only computed for the
+ * nearby nuclei. After all nuclei are added, setupScreening() sorts them into a
+ * cell list that is used to find the nuclei inside a given node.
+ */
 class NuclearFunction : public mrcpp::RepresentableFunction<3> {
 public:
     NuclearFunction() = default;
     void push_back(const std::string &atom, const mrcpp::Coord<3> &r, double p1, double p2);
     void push_back(const Nucleus &nuc, double p1, double p2);
+    void setupScreening();
 
     double getPrec() const { return this->prec; }
     Nuclei &getNuclei() { return this->nuclei; }
     const Nuclei &getNuclei() const { return this->nuclei; }
 
+    double evalf(const mrcpp::Coord<3> &r) const override;
     bool isVisibleAtScale(int scale, int nQuadPts) const override;
     bool isZeroOnInterval(const double *a, const double *b) const override;
 
@@ -57,6 +70,16 @@ protected:
     Nuclei nuclei;
     std::vector<double> param1;
     std::vector<double> param2;
+
+    std::vector<double> charges;     ///< Nuclear charges, contiguous for the Coulomb tail
+    std::vector<double> coords;      ///< Nuclear coordinates, three per nucleus
+    std::vector<double> short_range; ///< Distance beyond which nucleus i is a plain -Z/r
+    CellList nucList;                ///< Nuclear positions, set up by setupScreening()
+
+    /** @brief Model potential of nucleus i at distance R1 */
+    virtual double evalNucleus(int i, double R1) const = 0;
+    /** @brief Distance beyond which evalNucleus(i, R1) equals -Z/R1 to machine precision */
+    virtual double calcShortRange(int i) const = 0;
 };
 
 } // namespace mrchem
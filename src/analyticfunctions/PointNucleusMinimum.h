@@ -35,20 +35,6 @@ class PointNucleusMinimum : public NuclearFunction {
 public:
     PointNucleusMinimum() = default;
 
-    // zero order, just take constant
-    double evalf(const mrcpp::Coord<3> &r) const override {
-        double result = 0.0;
-        for (int i = 0; i < this->nuclei.size(); i++) {
-            const auto &R = this->nuclei[i].getCoord();
-            auto R1 = math_utils::calc_distance(R, r);
-            auto Z = this->nuclei[i].getCharge();
-            auto c = this->param2[i];
-            auto minPot = -Z * 23 / (c * 3.0 * mrcpp::root_pi);
-            result += std::max(-Z / R1, minPot);
-        }
-        return result;
-    }
-
     std::string getParamName1() const { return "Precision"; }
     std::string getParamName2() const { return "Smoothing"; }
     double calcParam1(double prec, const Nucleus &nuc) const { return prec; }
@@ -57,6 +43,18 @@ public:
         double tmp = 0.00435 * prec / std::pow(Z, 5.0);
         return std::cbrt(tmp);
     }
+
+protected:
+    // zero order, just take constant
+    double evalNucleus(int i, double R1) const override {
+        auto Z = this->charges[i];
+        auto c = this->param2[i];
+        auto minPot = -Z * 23 / (c * 3.0 * mrcpp::root_pi);
+        return std::max(-Z / R1, minPot);
+    }
+
+    // -Z/R1 reaches the minimum at R1 = Z / |minPot|
+    double calcShortRange(int i) const override { return this->param2[i] * 3.0 * mrcpp::root_pi / 23.0; }
 };
 
 } // namespace mrchem
@@ -35,25 +35,6 @@ class PointNucleusParabola : public NuclearFunction {
 public:
     PointNucleusParabola() = default;
 
-    // second order, the value and first derivative are equal at R0
-    double evalf(const mrcpp::Coord<3> &r) const override {
-        double result = 0.0;
-        for (int i = 0; i < this->nuclei.size(); i++) {
-            const auto &R = this->nuclei[i].getCoord();
-            auto R1 = math_utils::calc_distance(R, r);
-            auto Z = this->nuclei[i].getCharge();
-            auto c = this->param2[i];
-            auto a = Z * 23 / (c * 3.0 * mrcpp::root_pi);
-            auto R0 = 1.5 * Z / a;
-            auto b = 0.5 * Z / (R0 * R0 * R0);
-            if (R1 < R0)
-                result += -a + b * R1 * R1;
-            else
-                result += -Z / R1;
-        }
-        return result;
-    }
-
     std::string getParamName1() const { return "Precision"; }
     std::string getParamName2() const { return "Smoothing"; }
     double calcParam1(double prec, const Nucleus &nuc) const { return prec; }
@@ -62,6 +43,26 @@ public:
         double tmp = 0.00435 * prec / std::pow(Z, 5.0);
         return std::cbrt(tmp);
     }
+
+protected:
+    // second order, the value and first derivative are equal at R0
+    double evalNucleus(int i, double R1) const override {
+        auto Z = this->charges[i];
+        auto c = this->param2[i];
+        auto a = Z * 23 / (c * 3.0 * mrcpp::root_pi);
+        auto R0 = 1.5 * Z / a;
+        auto b = 0.5 * Z / (R0 * R0 * R0);
+        if (R1 < R0)
+            return -a + b * R1 * R1;
+        else
+            return -Z / R1;
+    }
+
+    double calcShortRange(int i) const override {
+        auto Z = this->charges[i];
+        auto a = Z * 23 / (this->param2[i] * 3.0 * mrcpp::root_pi);
+        return 1.5 * Z / a;
+    }
 };
 
 } // namespace mrchem
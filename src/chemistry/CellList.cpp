@@ -0,0 +1,167 @@
+/*
+ * MRChem, a numerical real-space code for molecular electronic structure
+ * calculations within the self-consistent field (SCF) approximations of quantum
+ * chemistry (Hartree-Fock and Density Functional Theory).
+ * Copyright (C) 2023 Stig Rune Jensen, Luca Frediani, Peter Wind and contributors.
+ *
+ * This file is part of MRChem.
+ *
+ * MRChem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * MRChem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MRChem.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For information on the complete list of contributors to MRChem, see:
+ * <https://mrchem.readthedocs.io/>
+ */
+
+#include "CellList.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <MRCPP/Printer>
+
+#include "Nucleus.h"
+#include "utils/math_utils.h"
+
+namespace mrchem {
+
+/** @brief Sort the points into cells
+ *
+ * @param coords: coordinates of the points
+ * @param cell_size: side length of the cubic cells
+ *
+ * The cell size is increased if needed to keep the number of cells
+ * comparable to the number of points.
+ */
+CellList::CellList(const std::vector<mrcpp::Coord<3>> &coords, double cell_size)
+        : cell_size(cell_size)
+        , coords(coords) {
+    if (cell_size <= 0.0) MSG_ABORT("Invalid cell size");
+    if (coords.empty()) return;
+
+    std::array<double, 3> r_min, r_max;
+    for (int d = 0; d < 3; d++) {
+        r_min[d] = coords[0][d];
+        r_max[d] = coords[0][d];
+    }
+    for (const auto &r : coords) {
+        for (int d = 0; d < 3; d++) {
+            r_min[d] = std::min(r_min[d], r[d]);
+            r_max[d] = std::max(r_max[d], r[d]);
+        }
+    }
+
+    // Avoid a grid that is mostly empty cells
+    double max_cells = 8.0 * coords.size() + 1.0;
+    while (true) {
+        double tot_cells = 1.0;
+        for (int d = 0; d < 3; d++) tot_cells *= std::floor((r_max[d] - r_min[d]) / this->cell_size) + 1.0;
+        if (tot_cells <= max_cells) break;
+        this->cell_size *= 2.0;
+    }
+
+    for (int d = 0; d < 3; d++) {
+        this->origin[d] = r_min[d];
+        this->n_cells[d] = cellCoord(r_max[d], d) + 1;
+    }
+
+    int n_tot = this->n_cells[0] * this->n_cells[1] * this->n_cells[2];
+    std::vector<int> point_cell(coords.size());
+    this->cell_start.assign(n_tot + 1, 0);
+    for (int n = 0; n < coords.size(); n++) {
+        const auto &r = coords[n];
+        point_cell[n] = cellIndex(cellCoord(r[0], 0), cellCoord(r[1], 1), cellCoord(r[2], 2));
+        this->cell_start[point_cell[n] + 1]++;
+    }
+    for (int c = 0; c < n_tot; c++) this->cell_start[c + 1] += this->cell_start[c];
+
+    std::vector<int> fill(this->cell_start.begin(), this->cell_start.end() - 1);
+    this->cell_points.resize(coords.size());
+    for (int n = 0; n < coords.size(); n++) this->cell_points[fill[point_cell[n]]++] = n;
+}
+
+/** @brief Sort the nuclear positions into cells
+ *
+ * @param nucs: nuclei, the point indices follow the ordering of this vector
+ * @param cell_size: side length of the cubic cells
+ */
+CellList::CellList(const Nuclei &nucs, double cell_size)
+        : CellList(
+              [&nucs]() {
+                  std::vector<mrcpp::Coord<3>> coords;
+                  for (const auto &nuc : nucs) coords.push_back(nuc.getCoord());
+                  return coords;
+              }(),
+              cell_size) {}
+
+/** @brief Return the indices of all points in the cells overlapping a cube around r
+ *
+ * @param r: center of the query region
+ * @param radius: half side length of the query cube
+ */
+std::vector<int> CellList::getCandidates(const mrcpp::Coord<3> &r, double radius) const {
+    std::vector<int> out;
+    forEachCandidate(r, radius, [&out](int n) { out.push_back(n); });
+    return out;
+}
+
+/** @brief Return the indices of all points within a given distance of r
+ *
+ * @param r: center of the query sphere
+ * @param radius: radius of the query sphere
+ */
+std::vector<int> CellList::getNeighbours(const mrcpp::Coord<3> &r, double radius) const {
+    std::vector<int> out;
+    forEachCandidate(r, radius, [this, &out, &r, radius](int n) {
+        if (math_utils::calc_distance(this->coords[n], r) <= radius) out.push_back(n);
+    });
+    return out;
+}
+
+/** @brief Return the index of the point closest to r
+ *
+ * @param r: query point
+ * @param exclude: index of a point to ignore, e.g. when r is one of the points
+ *
+ * The search cube is doubled from a single cell until the closest candidate is
+ * within the cube half width, in which case no point outside the cube can be
+ * closer. Returns -1 if there are no (other) points.
+ */
+int CellList::getNearest(const mrcpp::Coord<3> &r, int exclude) const {
+    if (this->coords.empty()) return -1;
+
+    // Half width of a cube around r that covers all cells
+    double max_width = 0.0;
+    for (int d = 0; d < 3; d++) {
+        double lo = this->origin[d];
+        double hi = this->origin[d] + this->n_cells[d] * this->cell_size;
+        max_width = std::max({max_width, std::abs(r[d] - lo), std::abs(r[d] - hi)});
+    }
+
+    for (double width = this->cell_size;; width *= 2.0) {
+        int nearest = -1;
+        double min_dist = 0.0;
+        forEachCandidate(r, width, [this, &r, &min_dist, &nearest, exclude](int n) {
+            if (n == exclude) return;
+            double dist = math_utils::calc_distance(this->coords[n], r);
+            if (nearest < 0 or dist < min_dist) {
+                min_dist = dist;
+                nearest = n;
+            }
+        });
+        if (nearest >= 0 and min_dist <= width) return nearest;
+        if (width >= max_width) return nearest;
+    }
+}
+
+} // namespace mrchem
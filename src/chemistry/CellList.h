@@ -0,0 +1,104 @@
+/*
+ * MRChem, a numerical real-space code for molecular electronic structure
+ * calculations within the self-consistent field (SCF) approximations of quantum
+ * chemistry (Hartree-Fock and Density Functional Theory).
+ * Copyright (C) 2023 Stig Rune Jensen, Luca Frediani, Peter Wind and contributors.
+ *
+ * This file is part of MRChem.
+ *
+ * MRChem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * MRChem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MRChem.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For information on the complete list of contributors to MRChem, see:
+ * <https://mrchem.readthedocs.io/>
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include <MRCPP/MWFunctions>
+
+#include "chemistry_fwd.h"
+
+namespace mrchem {
+
+/** @class CellList
+ *
+ * @brief Spatial index over a set of points in 3D space
+ *
+ * The points are sorted into a uniform grid of cubic cells spanning their bounding
+ * box. A query around a point only visits the cells that overlap the query region,
+ * so that the cost of finding the points within a fixed radius is independent of
+ * the total number of points. The cell size should be chosen comparable to the
+ * typical query radius (or the typical nearest neighbour distance).
+ */
+class CellList final {
+public:
+    CellList() = default;
+    CellList(const std::vector<mrcpp::Coord<3>> &coords, double cell_size);
+    CellList(const Nuclei &nucs, double cell_size);
+
+    int size() const { return this->coords.size(); }
+    double getCellSize() const { return this->cell_size; }
+    const mrcpp::Coord<3> &getCoord(int i) const { return this->coords[i]; }
+
+    std::vector<int> getCandidates(const mrcpp::Coord<3> &r, double radius) const;
+    std::vector<int> getNeighbours(const mrcpp::Coord<3> &r, double radius) const;
+    int getNearest(const mrcpp::Coord<3> &r, int exclude = -1) const;
+
+    /** @brief Visit all points in the cells overlapping a cube around r
+     *
+     * @param r: center of the query region
+     * @param radius: half side length of the query cube
+     * @param visit: called with the index of each candidate point
+     *
+     * All points within the given distance of r are visited, but also some points
+     * further away. The caller is responsible for the final distance check.
+     */
+    template <typename F> void forEachCandidate(const mrcpp::Coord<3> &r, double radius, F &&visit) const {
+        if (this->coords.empty()) return;
+        std::array<int, 3> lo, hi;
+        for (int d = 0; d < 3; d++) {
+            lo[d] = cellCoord(r[d] - radius, d);
+            hi[d] = cellCoord(r[d] + radius, d);
+            if (hi[d] < 0 or lo[d] >= this->n_cells[d]) return;
+            lo[d] = std::max(lo[d], 0);
+            hi[d] = std::min(hi[d], this->n_cells[d] - 1);
+        }
+        for (int i = lo[0]; i <= hi[0]; i++) {
+            for (int j = lo[1]; j <= hi[1]; j++) {
+                for (int k = lo[2]; k <= hi[2]; k++) {
+                    int c = cellIndex(i, j, k);
+                    for (int n = this->cell_start[c]; n < this->cell_start[c + 1]; n++) visit(this->cell_points[n]);
+                }
+            }
+        }
+    }
+
+private:
+    double cell_size{1.0};
+    std::array<double, 3> origin{};
+    std::array<int, 3> n_cells{};
+    std::vector<mrcpp::Coord<3>> coords;
+    std::vector<int> cell_start;  ///< Offset of each cell into cell_points (size n_cells + 1)
+    std::vector<int> cell_points; ///< Point indices sorted by cell
+
+    int cellCoord(double x, int d) const { return static_cast<int>(std::floor((x - this->origin[d]) / this->cell_size)); }
+    int cellIndex(int i, int j, int k) const { return (i * this->n_cells[1] + j) * this->n_cells[2] + k; }
+};
+
+} // namespace mrchem
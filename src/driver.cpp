@@ -29,6 +29,7 @@
 
 #include <filesystem>
 #include "driver.h"
+#include "mrenv.h"
 
 #include "chemistry/Molecule.h"
 #include "chemistry/Nucleus.h"
@@ -112,10 +113,12 @@ template <int I> RankOneOperator<I> get_operator(const std::string &name, const
 template <int I, int J> RankTwoOperator<I, J> get_operator(const std::string &name, const json &json_oper);
 void build_fock_operator(const json &input, Molecule &mol, FockBuilder &F, int order, bool is_dynamic = false);
 void init_properties(const json &json_prop, Molecule &mol);
+void check_mra(OrbitalVector &Phi, const std::string &name);
 
 namespace scf {
 bool guess_orbitals(const json &input, Molecule &mol);
 bool guess_energy(const json &input, Molecule &mol, FockBuilder &F);
+json run_multilevel(const json &json_solver, const json &json_fock, Molecule &mol, GroundStateSolver &solver);
 void write_orbitals(const json &input, Molecule &mol);
 void calc_properties(const json &input, Molecule &mol, const json &json_fock);
 void plot_quantities(const json &input, Molecule &mol);
@@ -123,6 +126,7 @@ void plot_quantities(const json &input, Molecule &mol);
 
 namespace rsp {
 bool guess_orbitals(const json &input, Molecule &mol);
+json run_multilevel(const json &json_rsp, const json &json_solver, Molecule &mol, LinearResponseSolver &solver, int d);
 void write_orbitals(const json &input, Molecule &mol, bool dynamic);
 void calc_properties(const json &input, Molecule &mol, int dir, double omega);
 } // namespace rsp
@@ -292,6 +296,8 @@ json driver::scf::run(const json &json_scf, Molecule &mol) {
         auto energy_thrs = json_scf["scf_solver"]["energy_thrs"];
         auto orbital_thrs = json_scf["scf_solver"]["orbital_thrs"];
         auto helmholtz_prec = json_scf["scf_solver"]["helmholtz_prec"];
+        auto lock_thrs = json_scf["scf_solver"].value("lock_thrs", -1.0);
+        auto lock_iterations = json_scf["scf_solver"].value("lock_iterations", 3);
 
         GroundStateSolver solver;
         solver.setHistory(kain);
@@ -307,7 +313,11 @@ json driver::scf::run(const json &json_scf, Molecule &mol) {
         solver.setHelmholtzPrec(helmholtz_prec);
         solver.setOrbitalPrec(start_prec, final_prec);
         solver.setThreshold(orbital_thrs, energy_thrs);
+        solver.setOrbitalLocking(lock_thrs, lock_iterations);
 
+        if (json_scf["scf_solver"].contains("multilevel")) {
+            json_out["multilevel_solver"] = scf::run_multilevel(json_scf["scf_solver"], json_fock, mol, solver);
+        }
         json_out["scf_solver"] = solver.optimize(mol, F);
         json_out["success"] = json_out["scf_solver"]["converged"];
     }
@@ -325,6 +335,81 @@ json driver::scf::run(const json &json_scf, Molecule &mol) {
     return json_out;
 }
 
+/** @brief Run the low order stage of a multilevel SCF optimization
+ *
+ * The orbitals are projected onto an MRA with lower polynomial order and
+ * optimized there, with a separate Fock operator, to the multilevel precision.
+ * They are then projected back onto the global MRA. The low order stage uses
+ * a copy of the final solver with thresholds scaled to the multilevel precision
+ * and without checkpointing. The final solver continues from the multilevel
+ * precision. Returns a JSON record of the low order optimization.
+ *
+ * Functions and operators keep the MRA they were built in. Everything used in
+ * the low order stage is therefore built inside it and destroyed before the
+ * global MRA is restored, and the Fock operator of the final solver must not
+ * be set up while the low order MRA is active.
+ *
+ * This function expects the "scf_solver" subsection of the input.
+ */
+json driver::scf::run_multilevel(const json &json_solver, const json &json_fock, Molecule &mol, GroundStateSolver &solver) {
+    int order = json_solver["multilevel"]["order"];
+    double ml_prec = json_solver["multilevel"]["prec"];
+    double start_prec = json_solver["start_prec"];
+    double final_prec = json_solver["final_prec"];
+    double orbital_thrs = json_solver["orbital_thrs"];
+    double energy_thrs = json_solver["energy_thrs"];
+
+    if (order >= MRA->getOrder() or ml_prec <= final_prec) {
+        MSG_WARN("Multilevel stage would not be cheaper, skipping it");
+        return {};
+    }
+
+    double scale = ml_prec / final_prec;
+    GroundStateSolver solver_low = solver;
+    solver_low.setCheckpoint(false);
+    solver_low.setOrbitalPrec(std::max(start_prec, ml_prec), ml_prec);
+    solver_low.setThreshold((orbital_thrs > 0.0) ? scale * orbital_thrs : orbital_thrs, (energy_thrs > 0.0) ? scale * energy_thrs : energy_thrs);
+
+    json json_out;
+    auto &Phi = mol.getOrbitals();
+    auto *MRA_final = MRA;
+    std::unique_ptr<mrcpp::MultiResolutionAnalysis<3>> MRA_low(mrenv::create_mra(order));
+    {
+        print_utils::headline(0, "Low Order Multilevel Stage");
+        print_utils::scalar(0, "Polynomial order", order, "", 0, false);
+        print_utils::scalar(0, "Final precision ", ml_prec, "", 5, true);
+        mrenv::set_mra(MRA_low.get());
+        Phi = orbital::reproject(ml_prec, Phi);
+
+        // F_low lives in the low order MRA and must not outlive this scope
+        FockBuilder F_low;
+        driver::build_fock_operator(json_fock, mol, F_low, 0);
+        if (F_low.getExchangeOperator()) F_low.getExchangeOperator()->setPreCompute();
+        json_out = solver_low.optimize(mol, F_low);
+
+        mrenv::set_mra(MRA_final);
+        Phi = orbital::reproject(ml_prec, Phi);
+    }
+    check_mra(Phi, "Ground state orbitals");
+    solver.setOrbitalPrec(std::min(start_prec, ml_prec), final_prec);
+    return json_out;
+}
+
+/** @brief Abort if any locally available orbital is not in the global MRA
+ *
+ * Used after the MRA swaps of the multilevel stages, where functions built in
+ * one MRA must not be reused in another.
+ */
+void driver::check_mra(OrbitalVector &Phi, const std::string &name) {
+    for (auto &phi : Phi) {
+        if (not mrcpp::mpi::my_orb(phi)) continue;
+        bool ok = true;
+        if (phi.hasReal()) ok &= (phi.real().getMRA() == *MRA);
+        if (phi.hasImag()) ok &= (phi.imag().getMRA() == *MRA);
+        if (not ok) MSG_ABORT(name << " are not in the global MRA");
+    }
+}
+
 /** @brief Run initial guess calculation for the orbitals
  *
  * This function will update the ground state orbitals and the Fock
@@ -352,6 +437,7 @@ bool driver::scf::guess_orbitals(const json &json_guess, Molecule &mol) {
     auto cube_p = json_guess["file_CUBE_p"];
     auto cube_a = json_guess["file_CUBE_a"];
     auto cube_b = json_guess["file_CUBE_b"];
+    auto cube_tricubic = json_guess["cube_tricubic"];
 
     int mult = mol.getMultiplicity();
     if (restricted && mult != 1) {
@@ -395,7 +481,7 @@ bool driver::scf::guess_orbitals(const json &json_guess, Molecule &mol) {
     } else if (type == "gto") {
         success = initial_guess::gto::setup(Phi, prec, screen, gto_bas, gto_p, gto_a, gto_b);
     } else if (type == "cube") {
-        success = initial_guess::cube::setup(Phi, prec, cube_p, cube_a, cube_b);
+        success = initial_guess::cube::setup(Phi, prec, cube_p, cube_a, cube_b, cube_tricubic);
     } else {
         MSG_ERROR("Invalid initial guess");
         success = false;
@@ -625,7 +711,7 @@ void driver::scf::calc_properties(const json &json_prop, Molecule &mol, const js
             const auto &id = item.key();
             double prec = item.value()["precision"];
 
-            HirshfeldPartition partitioner(mol, data_dir);
+            HirshfeldPartition partitioner(mol, data_dir, prec);
             mrchem::Density rho(false);
             mrchem::density::compute(prec, rho, Phi, DensityType::Total);
             Eigen::VectorXd charges = Eigen::VectorXd::Zero(mol.getNNuclei());
@@ -682,43 +768,29 @@ void driver::scf::plot_quantities(const json &json_plot, Molecule &mol) {
     plt.setRange(A, B, C);
 
     if (dens_plot) {
-        Density rho(false);
-
-        t_lap.start();
-        std::string fname = path + "/rho_t";
-        density::compute(-1.0, rho, Phi, DensityType::Total);
-        if (line) plt.linePlot(npts, rho, fname);
-        if (surf) plt.surfPlot(npts, rho, fname);
-        if (cube) plt.cubePlot(npts, rho, fname);
-        rho.free(NUMBER::Total);
-        mrcpp::print::time(1, fname, t_lap);
-
+        std::vector<std::string> names = {"rho_t"};
+        std::vector<DensityType> spins = {DensityType::Total};
         if (orbital::size_singly(Phi) > 0) {
-            t_lap.start();
-            fname = path + "/rho_s";
-            density::compute(-1.0, rho, Phi, DensityType::Spin);
-            if (line) plt.linePlot(npts, rho, fname);
-            if (surf) plt.surfPlot(npts, rho, fname);
-            if (cube) plt.cubePlot(npts, rho, fname);
-            mrcpp::print::time(1, fname, t_lap);
-            rho.free(NUMBER::Total);
-
-            t_lap.start();
-            fname = path + "/rho_a";
-            density::compute(-1.0, rho, Phi, DensityType::Alpha);
-            if (line) plt.linePlot(npts, rho, fname);
-            if (surf) plt.surfPlot(npts, rho, fname);
-            if (cube) plt.cubePlot(npts, rho, fname);
-            mrcpp::print::time(1, fname, t_lap);
-            rho.free(NUMBER::Total);
+            names.insert(names.end(), {"rho_s", "rho_a", "rho_b"});
+            spins.insert(spins.end(), {DensityType::Spin, DensityType::Alpha, DensityType::Beta});
+        }
 
+        // All spin densities are computed in a single pass over the orbitals
+        t_lap.start();
+        std::vector<Density> rho;
+        for (int k = 0; k < static_cast<int>(spins.size()); k++) rho.emplace_back(false);
+        std::vector<Density *> rho_p;
+        for (auto &rho_k : rho) rho_p.push_back(&rho_k);
+        density::compute(-1.0, rho_p, Phi, spins);
+        mrcpp::print::time(1, "Computing densities", t_lap);
+
+        for (int k = 0; k < static_cast<int>(rho.size()); k++) {
             t_lap.start();
-            fname = path + "/rho_b";
-            density::compute(-1.0, rho, Phi, DensityType::Beta);
-            if (line) plt.linePlot(npts, rho, fname);
-            if (surf) plt.surfPlot(npts, rho, fname);
-            if (cube) plt.cubePlot(npts, rho, fname);
-            rho.free(NUMBER::Total);
+            std::string fname = path + "/" + names[k];
+            if (line) plt.linePlot(npts, rho[k], fname);
+            if (surf) plt.surfPlot(npts, rho[k], fname);
+            if (cube) plt.cubePlot(npts, rho[k], fname);
+            rho[k].free(NUMBER::Total);
             mrcpp::print::time(1, fname, t_lap);
         }
     }
@@ -865,6 +937,9 @@ json driver::rsp::run(const json &json_rsp, Molecule &mol) {
             solver.setThreshold(orbital_thrs, property_thrs);
             solver.setOrthPrec(orth_prec);
 
+            if (json_comp["rsp_solver"].contains("multilevel")) {
+                comp_out["multilevel_solver"] = rsp::run_multilevel(json_rsp, json_comp["rsp_solver"], mol, solver, d);
+            }
             comp_out["rsp_solver"] = solver.optimize(omega, mol, F_0, F_1);
             json_out["success"] = comp_out["rsp_solver"]["converged"];
         }
@@ -889,6 +964,86 @@ json driver::rsp::run(const json &json_rsp, Molecule &mol) {
     return json_out;
 }
 
+/** @brief Run the low order stage of a multilevel response optimization
+ *
+ * Like the SCF version, but the unperturbed orbitals are also projected onto the
+ * low order MRA, and restored afterwards. Both Fock operators and the perturbation
+ * operator of component d are rebuilt in the low order MRA. Only the perturbed
+ * orbitals are projected back.
+ *
+ * The F_0, F_1 and h_1 of rsp::run are built in the global MRA (magnetic
+ * perturbations hold derivative operators) and must not be used in the low order
+ * stage, and the operators of the low order stage must not outlive it. The
+ * AZORA kappa is reprojected when the MRA changes, see AZoraPotential::hasProjection.
+ *
+ * This function expects a single subsection entry in the "rsp_calculations"
+ * vector of the input, and the "rsp_solver" subsection of one of its components.
+ */
+json driver::rsp::run_multilevel(const json &json_rsp, const json &json_solver, Molecule &mol, LinearResponseSolver &solver, int d) {
+    int order = json_solver["multilevel"]["order"];
+    double ml_prec = json_solver["multilevel"]["prec"];
+    double start_prec = json_solver["start_prec"];
+    double final_prec = json_solver["final_prec"];
+    double orbital_thrs = json_solver["orbital_thrs"];
+    double property_thrs = json_solver["property_thrs"];
+
+    if (order >= MRA->getOrder() or ml_prec <= final_prec) {
+        MSG_WARN("Multilevel stage would not be cheaper, skipping it");
+        return {};
+    }
+
+    double omega = json_rsp["frequency"];
+    bool dynamic = json_rsp["dynamic"];
+    const auto &json_unpert = json_rsp["unperturbed"];
+    double unpert_prec = json_unpert["precision"];
+
+    double scale = ml_prec / final_prec;
+    LinearResponseSolver solver_low = solver;
+    solver_low.setCheckpoint(false);
+    solver_low.setOrbitalPrec(std::max(start_prec, ml_prec), ml_prec);
+    solver_low.setThreshold((orbital_thrs > 0.0) ? scale * orbital_thrs : orbital_thrs, (property_thrs > 0.0) ? scale * property_thrs : property_thrs);
+
+    json json_out;
+    auto &Phi = mol.getOrbitals();
+    auto &X = mol.getOrbitalsX();
+    auto &Y = mol.getOrbitalsY();
+    OrbitalVector Phi_final = Phi;
+    auto *MRA_final = MRA;
+    std::unique_ptr<mrcpp::MultiResolutionAnalysis<3>> MRA_low(mrenv::create_mra(order));
+    {
+        print_utils::headline(0, "Low Order Multilevel Stage");
+        print_utils::scalar(0, "Polynomial order", order, "", 0, false);
+        print_utils::scalar(0, "Final precision ", ml_prec, "", 5, true);
+        mrenv::set_mra(MRA_low.get());
+        Phi = orbital::reproject(ml_prec, Phi_final);
+        X = orbital::reproject(ml_prec, X);
+        if (dynamic) Y = orbital::reproject(ml_prec, Y);
+
+        // F_0, F_1 and h_low live in the low order MRA and must not outlive this scope
+        FockBuilder F_0;
+        driver::build_fock_operator(json_unpert["fock_operator"], mol, F_0, 0);
+        F_0.setup(std::max(unpert_prec, ml_prec));
+
+        FockBuilder F_1;
+        driver::build_fock_operator(json_rsp["fock_operator"], mol, F_1, 1, dynamic);
+        auto h_low = driver::get_operator<3>(json_rsp["perturbation"]["operator"], json_rsp["perturbation"]);
+        F_1.perturbation() = h_low[d];
+
+        json_out = solver_low.optimize(omega, mol, F_0, F_1);
+        F_0.clear();
+
+        mrenv::set_mra(MRA_final);
+        X = orbital::reproject(ml_prec, X);
+        if (dynamic) Y = orbital::reproject(ml_prec, Y);
+        Phi = Phi_final;
+    }
+    check_mra(Phi, "Ground state orbitals");
+    check_mra(X, "Perturbed orbitals");
+    if (dynamic) check_mra(Y, "Perturbed orbitals");
+    solver.setOrbitalPrec(std::min(start_prec, ml_prec), final_prec);
+    return json_out;
+}
+
 /** @brief Run initial guess calculation for the response orbitals
  *
  * This function will update the ground state orbitals and the Fock
@@ -1092,6 +1247,11 @@ void driver::build_fock_operator(const json &json_fock, Molecule &mol, FockBuild
         bool include_xc = json_fock["zora_operator"]["include_xc"];
         bool is_azora = json_fock["zora_operator"]["isAZORA"];
         F.setZoraType(include_nuclear, include_coulomb, include_xc, is_azora);
+        if (json_fock["zora_operator"].contains("rebuild_thrs")) {
+            double rebuild_thrs = json_fock["zora_operator"]["rebuild_thrs"];
+            int freeze_iter = json_fock["zora_operator"]["freeze_iteration"];
+            F.setZoraReuse(rebuild_thrs, freeze_iter);
+        }
         if (is_azora) {
             std::string azora_dir_src = AZORA_POTENTIALS_SOURCE_DIR;
             std::string azora_dir_install = AZORA_POTENTIALS_INSTALL_DIR;
@@ -1131,6 +1291,13 @@ void driver::build_fock_operator(const json &json_fock, Molecule &mol, FockBuild
         auto P_p = std::make_shared<PoissonOperator>(*MRA, poisson_prec);
         if (order == 0) {
             auto J_p = std::make_shared<CoulombOperator>(P_p, Phi_p, shared_memory);
+            auto incl_nuc = json_fock["coulomb_operator"].value("include_nuclear", false);
+            if (incl_nuc) {
+                if (F.getNuclearOperator() == nullptr) MSG_ABORT("Combined electrostatics requires the nuclear operator");
+                auto nuc_exp = json_fock["coulomb_operator"]["nuclear_exponent"];
+                auto &V_nuc = static_cast<QMPotential &>(F.getNuclearOperator()->getRaw(0, 0));
+                J_p->includeNuclear(poisson_prec, nuclei, V_nuc, nuc_exp);
+            }
             F.getCoulombOperator() = J_p;
         } else if (order == 1) {
             auto J_p = std::make_shared<CoulombOperator>(P_p, Phi_p, X_p, Y_p, shared_memory);
@@ -1216,7 +1383,13 @@ void driver::build_fock_operator(const json &json_fock, Molecule &mol, FockBuild
             DHScreening dhscreening(cavity_ion, kappa_o, kformulation); // this is now deciding the pb formulation, but it really shouldn't, the formulation here is for the DHScreening where we
                                                                         // have 4 different parametrizations, not all implemented yet.
             dhscreening.printParameters();
-            scrf_p = std::make_unique<PBESolver>(dielectric_func, dhscreening, rho_nuc, P_p, D_p, kain, max_iter, dynamic_thrs, density_type);
+            auto pb_p = std::make_unique<PBESolver>(dielectric_func, dhscreening, rho_nuc, P_p, D_p, kain, max_iter, dynamic_thrs, density_type);
+            if (json_fock["reaction_operator"]["newton"]) {
+                auto micro_iter = json_fock["reaction_operator"]["newton_micro_iter"];
+                auto eta = json_fock["reaction_operator"]["newton_eta"];
+                pb_p->setNewton(micro_iter, eta);
+            }
+            scrf_p = std::move(pb_p);
         } else if (solver_type == "Linearized_Poisson-Boltzmann") {
             DHScreening dhscreening(cavity_ion, kappa_o, kformulation); // this is now deciding the pb formulation, but it really shouldn't, the formulation here is for the DHScreening where we
                                                                         // have 4 different parametrizations, not all implemented yet.
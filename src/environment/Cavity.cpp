@@ -24,8 +24,10 @@
  */
 #include "Cavity.h"
 
+#include <algorithm>
 #include <cmath>
 #include <functional>
+#include <limits>
 #include <vector>
 
 #include <MRCPP/mrcpp_declarations.h>
@@ -35,6 +37,42 @@
 
 namespace mrchem {
 namespace detail {
+// Spheres beyond R_i + cutoff_width * sigma_i give 0.5 * (1 + erf(s / sigma)) == 1.0 exactly
+const double cutoff_width = 6.0;
+
+/** @relates mrchem::Cavity
+ *  @brief Contribution of a single sphere to the logarithmic derivative of the Cavity.
+ *  @details Returns \f$\partial_x C_i / (1 - C_i)\f$ with the same safeguards against small numbers
+ *  as used in #gradCavity, and multiplies the factor \f$1 - C_i\f$ into C.
+ */
+double gradCavityTerm(const mrcpp::Coord<3> &r, int index, const mrcpp::Coord<3> &center, double radius, double sigma, double &C) {
+    auto sqrt_pi = std::sqrt(mrcpp::pi);
+
+    auto s = math_utils::calc_distance(center, r) - radius;
+    auto ds = (r[index] - center[index]) / (math_utils::calc_distance(center, r));
+    auto Theta = 0.5 * (1 + std::erf(s / sigma));
+    auto Ci = 1.0 - Theta;
+    C *= 1.0 - Ci;
+
+    double DCi = -(1.0 / (sigma * sqrt_pi)) * std::exp(-std::pow(s / sigma, 2.0)) * ds;
+
+    double numerator = DCi;
+    double denominator = 1.0 - Ci;
+
+    if (((1.0 - Ci) < 1.0e-12) and ((1.0 - Ci) >= 0)) {
+        denominator = 1.0e-12;
+    } else if (((1.0 - Ci) > -1.0e-12) and ((1.0 - Ci) <= 0)) {
+        denominator = -1.0e-12;
+    }
+
+    if ((DCi < 1.0e-12) and (DCi >= 0)) {
+        numerator = 1.0e-12;
+    } else if ((DCi > -1.0e-12) and (DCi <= 0)) {
+        numerator = -1.0e-12;
+    }
+    return numerator / denominator;
+}
+
 /**  @relates mrchem::Cavity
  *   @brief Constructs a single element of the gradient of the Cavity.
  *   @details This constructs the analytical partial derivative of the Cavity \f$C\f$ with respect to \f$x\f$, \f$y\f$ or \f$z\f$
@@ -59,37 +97,7 @@ namespace detail {
 auto gradCavity(const mrcpp::Coord<3> &r, int index, const std::vector<mrcpp::Coord<3>> &centers, const std::vector<double> &radii, const std::vector<double> &widths) -> double {
     auto C = 1.0;
     auto DC = 0.0;
-    auto sqrt_pi = std::sqrt(mrcpp::pi);
-
-    for (int i = 0; i < centers.size(); ++i) {
-        auto center = centers[i];
-        auto radius = radii[i];
-        auto sigma = widths[i];
-
-        auto s = math_utils::calc_distance(center, r) - radius;
-        auto ds = (r[index] - center[index]) / (math_utils::calc_distance(center, r));
-        auto Theta = 0.5 * (1 + std::erf(s / sigma));
-        auto Ci = 1.0 - Theta;
-        C *= 1.0 - Ci;
-
-        double DCi = -(1.0 / (sigma * sqrt_pi)) * std::exp(-std::pow(s / sigma, 2.0)) * ds;
-
-        double numerator = DCi;
-        double denominator = 1.0 - Ci;
-
-        if (((1.0 - Ci) < 1.0e-12) and ((1.0 - Ci) >= 0)) {
-            denominator = 1.0e-12;
-        } else if (((1.0 - Ci) > -1.0e-12) and ((1.0 - Ci) <= 0)) {
-            denominator = -1.0e-12;
-        }
-
-        if ((DCi < 1.0e-12) and (DCi >= 0)) {
-            numerator = 1.0e-12;
-        } else if ((DCi > -1.0e-12) and (DCi <= 0)) {
-            numerator = -1.0e-12;
-        }
-        DC += numerator / denominator;
-    }
+    for (int i = 0; i < centers.size(); ++i) DC += gradCavityTerm(r, index, centers[i], radii[i], widths[i], C);
     DC = C * DC;
     return DC;
 }
@@ -105,9 +113,23 @@ Cavity::Cavity(const std::vector<mrcpp::Coord<3>> &coords, const std::vector<dou
     // compute the radii
     for (auto i = 0; i < this->radii_0.size(); ++i) { this->radii.push_back(this->radii_0[i] * this->alphas[i] + this->betas[i] * this->sigmas[i]); }
 
-    auto p_gradcavity = [&cs = this->centers, &rs = this->radii, &ws = this->sigmas](const mrcpp::Coord<3> &r, int index) { return detail::gradCavity(r, index, cs, rs, ws); };
+    // set up the spatial index and the bounds used in isZeroOnInterval
+    for (auto i = 0; i < this->radii.size(); ++i) {
+        this->cutoffs.push_back(this->radii[i] + detail::cutoff_width * this->sigmas[i]);
+        this->max_cutoff = std::max(this->max_cutoff, this->cutoffs[i]);
+    }
+    if (not this->centers.empty()) this->sphere_list = CellList(this->centers, this->max_cutoff);
+    for (int d = 0; d < 3; d++) {
+        this->min_of_max_out[d] = std::numeric_limits<double>::max();
+        this->max_of_min_out[d] = std::numeric_limits<double>::lowest();
+        for (auto k = 0; k < this->centers.size(); ++k) {
+            this->min_of_max_out[d] = std::min(this->min_of_max_out[d], this->centers[k][d] + this->radii[k] + 3.0 * this->sigmas[k]);
+            this->max_of_min_out[d] = std::max(this->max_of_min_out[d], this->centers[k][d] - this->radii[k] - 3.0 * this->sigmas[k]);
+        }
+    }
+
     for (auto i = 0; i < 3; i++) {
-        this->gradvector.push_back([i, p_gradcavity](const mrcpp::Coord<3> &r) -> double { return p_gradcavity(r, i); });
+        this->gradvector.push_back([i, this](const mrcpp::Coord<3> &r) -> double { return evalGradient(r, i); });
     }
 }
 
@@ -117,20 +139,36 @@ Cavity::Cavity(const std::vector<mrcpp::Coord<3>> &coords, const std::vector<dou
  */
 double Cavity::evalf(const mrcpp::Coord<3> &r) const {
     auto C = 1.0;
-    for (int i = 0; i < centers.size(); i++) {
-        auto center = this->centers[i];
-        auto radius = this->radii[i];
-        auto sigma = this->sigmas[i];
+    this->sphere_list.forEachCandidate(r, this->max_cutoff, [this, &r, &C](int i) {
+        auto dist = math_utils::calc_distance(this->centers[i], r);
+        if (dist >= this->cutoffs[i]) return;
 
-        auto s = math_utils::calc_distance(center, r) - radius;
-        auto Theta = 0.5 * (1 + std::erf(s / sigma));
+        auto s = dist - this->radii[i];
+        auto Theta = 0.5 * (1 + std::erf(s / this->sigmas[i]));
         auto Ci = 1 - Theta;
         C *= 1 - Ci;
-    }
+    });
     C = 1 - C;
     return C;
 }
 
+/** @brief Evaluates a component of the gradient of the cavity at a 3D point \f$\mathbf{r}\f$
+ *  @param r coordinate of 3D point at which the gradient is to be evaluated at.
+ *  @param index direction of differentiation (0->x, 1->y and 2->z).
+ *  @details Same as detail::gradCavity, but only spheres within their cutoff distance are included.
+ *  The remaining spheres only add the 1.0e-12 safeguard values to the sum in the brute-force version.
+ */
+double Cavity::evalGradient(const mrcpp::Coord<3> &r, int index) const {
+    auto C = 1.0;
+    auto DC = 0.0;
+    this->sphere_list.forEachCandidate(r, this->max_cutoff, [this, &r, index, &C, &DC](int i) {
+        if (math_utils::calc_distance(this->centers[i], r) >= this->cutoffs[i]) return;
+        DC += detail::gradCavityTerm(r, index, this->centers[i], this->radii[i], this->sigmas[i], C);
+    });
+    DC = C * DC;
+    return DC;
+}
+
 void Cavity::printParameters() const {
     // Collect relevant quantities
     auto coords = this->centers;
@@ -199,6 +237,10 @@ bool Cavity::isVisibleAtScale(int scale, int nQuadPts) const {
 }
 
 bool Cavity::isZeroOnInterval(const double *a, const double *b) const {
+    // the outer bounds are tested for all spheres at once
+    for (int i = 0; i < 3; ++i) {
+        if (a[i] > this->min_of_max_out[i] || b[i] < this->max_of_min_out[i]) return true;
+    }
     for (int k = 0; k < this->centers.size(); ++k) {
         auto center = this->centers[k];
         auto radius = this->radii[k];
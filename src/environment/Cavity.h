@@ -31,6 +31,8 @@
 #include <MRCPP/MWFunctions>
 #include <MRCPP/mrcpp_declarations.h>
 
+#include "chemistry/CellList.h"
+
 namespace mrchem {
 /** @class Cavity
  * @brief Interlocking spheres cavity centered on the nuclei of the molecule.
@@ -60,6 +62,10 @@ namespace mrchem {
  *  - \f$\alpha_{i}\f$ is a scaling factor. By default, 1.1
  *  - \f$\beta_{i}\f$ is a width scaling factor. By default, 0.5
  *  - \f$\sigma_{i}\f$ is the width. By default, 0.2 bohr
+ *
+ * Beyond a distance \f$R_i + 6\sigma_i\f$ from its center a sphere contributes a factor of exactly
+ * one (in double precision) to the product. The spheres are therefore stored in a CellList, and
+ * evaluation only visits the spheres that are close enough to contribute.
  */
 
 class Cavity final : public mrcpp::RepresentableFunction<3> {
@@ -80,6 +86,7 @@ public:
             : Cavity(coords, R, std::vector<double>(R.size(), 1.0), std::vector<double>(R.size(), 0.0), std::vector<double>(R.size(), sigma)) {}
 
     double evalf(const mrcpp::Coord<3> &r) const override;
+    double evalGradient(const mrcpp::Coord<3> &r, int index) const;
 
     auto getGradVector() const { return this->gradvector; }
 
@@ -101,6 +108,11 @@ protected:
     std::vector<double> radii;                                               //!< Contains the radius of each sphere in #Center. \f$R_i = \alpha_{i} R_{0,i} + \beta_{i}\sigma_{i}\f$
     std::vector<mrcpp::Coord<3>> centers;                                    //!< Contains each of the spheres centered on the nuclei of the Molecule.
     std::vector<std::function<double(const mrcpp::Coord<3> &r)>> gradvector; //< Analytical derivatives of the Cavity.
+    std::vector<double> cutoffs;                                             //!< Distance beyond which each sphere does not contribute.
+    double max_cutoff{0.0};                                                  //!< Largest value in #cutoffs.
+    CellList sphere_list;                                                    //!< Spatial index over #centers.
+    std::array<double, 3> min_of_max_out{};                                  //!< Smallest outer upper bound over all spheres, per direction.
+    std::array<double, 3> max_of_min_out{};                                  //!< Largest outer lower bound over all spheres, per direction.
 
     bool isVisibleAtScale(int scale, int nQuadPts) const override;
     bool isZeroOnInterval(const double *a, const double *b) const override;
@@ -56,11 +56,15 @@ GPESolver::GPESolver(const Permittivity &e, const Density &rho_nuc, PoissonOpera
         , epsilon(e)
         , rho_nuc(rho_nuc)
         , Vr_n(false)
+        , rho_vac(false)
+        , V_vac(false)
+        , eps_inv(false)
         , derivative(D)
         , poisson(P) {}
 
 GPESolver::~GPESolver() {
     this->rho_nuc.free(NUMBER::Real);
+    clearDielectric();
     clear();
 }
 
@@ -68,10 +72,35 @@ void GPESolver::clear() {
     this->apply_prec = -1.0;
 }
 
+void GPESolver::setupDielectric(double prec) {
+    if (this->dielectric_prec > 0.0 and std::abs(this->dielectric_prec - prec) < mrcpp::MachineZero) return;
+    clearDielectric();
+
+    Timer timer;
+    auto C_pin = this->epsilon.getCavity_p();
+    auto grad_C = C_pin->getGradVector();
+    for (int d = 0; d < 3; d++) {
+        mrcpp::AnalyticFunction<3> d_cav(grad_C[d]);
+        this->d_cavity.emplace_back(false);
+        mrcpp::cplxfunc::project(this->d_cavity.back(), d_cav, NUMBER::Real, prec);
+    }
+    auto eps_inv_func = mrcpp::AnalyticFunction<3>([this](const mrcpp::Coord<3> &r) { return 1.0 / this->epsilon.evalf(r); });
+    mrcpp::cplxfunc::project(this->eps_inv, eps_inv_func, NUMBER::Real, prec);
+    this->dielectric_prec = prec;
+    print_utils::qmfunction(3, "Inverse permittivity", this->eps_inv, timer);
+}
+
+void GPESolver::clearDielectric() {
+    for (auto &d_cav : this->d_cavity) d_cav.free(NUMBER::Total);
+    this->d_cavity.clear();
+    this->eps_inv.free(NUMBER::Total);
+    this->dielectric_prec = -1.0;
+}
+
 double GPESolver::setConvergenceThreshold(double prec) {
     // converge_thrs should be in the interval [prec, 1.0]
     this->conv_thrs = prec;
-    if (this->dynamic_thrs and this->mo_residual > 10 * prec) this->conv_thrs = std::min(1.0, this->mo_residual);
+    if (this->dynamic_thrs) this->conv_thrs = std::min(1.0, std::max(prec, this->mo_residual));
     return this->conv_thrs;
 }
 
@@ -102,10 +131,10 @@ void GPESolver::computeGamma(mrcpp::ComplexFunction &potential, mrcpp::ComplexFu
     resetComplexFunction(out_gamma);
 
     for (int d = 0; d < 3; d++) {
-        auto C_pin = this->epsilon.getCavity_p();
-        mrcpp::AnalyticFunction<3> d_cav(C_pin->getGradVector()[d]);
         mrcpp::ComplexFunction cplxfunc_prod;
-        mrcpp::cplxfunc::multiply(cplxfunc_prod, get_func(d_V, d), d_cav, this->apply_prec, 1);
+        cplxfunc_prod.alloc(NUMBER::Real);
+        mrcpp::copy_grid(cplxfunc_prod.real(), get_func(d_V, d));
+        mrcpp::multiply(this->apply_prec, cplxfunc_prod.real(), 1.0, get_func(d_V, d), this->d_cavity[d].real(), 1);
         // add result into out_gamma
         if (d == 0) {
             mrcpp::cplxfunc::deep_copy(out_gamma, cplxfunc_prod);
@@ -125,11 +154,10 @@ mrcpp::ComplexFunction GPESolver::solvePoissonEquation(const mrcpp::ComplexFunct
     mrcpp::ComplexFunction Vr_np1;
     Vr_np1.alloc(NUMBER::Real);
 
-    auto eps_inv_func = mrcpp::AnalyticFunction<3>([this](const mrcpp::Coord<3> &r) { return 1.0 / this->epsilon.evalf(r); });
     Density rho_tot(false);
     computeDensities(rho_el, rho_tot);
 
-    mrcpp::cplxfunc::multiply(first_term, rho_tot, eps_inv_func, this->apply_prec);
+    mrcpp::cplxfunc::multiply(first_term, rho_tot, this->eps_inv, this->apply_prec);
 
     mrcpp::cplxfunc::add(rho_eff, 1.0, first_term, -1.0, rho_tot, -1.0);
     rho_tot.free(NUMBER::Real);
@@ -160,15 +188,47 @@ void GPESolver::accelerateConvergence(mrcpp::ComplexFunction &dfunc, mrcpp::Comp
     dPhi_n.clear();
 }
 
-void GPESolver::runMicroIterations(const mrcpp::ComplexFunction &V_vac, const Density &rho_el) {
-    KAIN kain(this->history);
-    kain.setLocalPrintLevel(10);
+void GPESolver::updateVacuumPotential(const Density &rho_tot) {
+    bool incremental = this->V_vac.hasReal() and std::abs(this->vacuum_prec - this->apply_prec) < mrcpp::MachineZero;
+
+    mrcpp::ComplexFunction V_new;
+    V_new.alloc(NUMBER::Real);
+    if (incremental) {
+        Density d_rho(false);
+        mrcpp::cplxfunc::add(d_rho, 1.0, rho_tot, -1.0, this->rho_vac, -1.0);
+        mrcpp::ComplexFunction dV_vac;
+        dV_vac.alloc(NUMBER::Real);
+        mrcpp::apply(this->apply_prec, dV_vac.real(), *poisson, d_rho.real());
+        mrcpp::cplxfunc::add(V_new, 1.0, this->V_vac, 1.0, dV_vac, -1.0);
+        V_new.crop(this->apply_prec);
+    } else {
+        mrcpp::apply(this->apply_prec, V_new.real(), *poisson, const_cast<Density &>(rho_tot).real());
+        if (this->kain != nullptr) this->kain->clear();
+    }
+    this->V_vac = V_new;
+    this->rho_vac = rho_tot;
+    this->vacuum_prec = this->apply_prec;
+}
 
+void GPESolver::runMicroIterations(const mrcpp::ComplexFunction &V_vac, const Density &rho_el) {
+    mrcpp::print::separator(3, '-');
+    auto update = 10.0;
+    auto iter = iterateReactionPotential(V_vac, rho_el, this->conv_thrs, this->max_iter, update);
+    if (update >= this->conv_thrs) println(0, "Reaction potential failed to converge after " << iter << " iterations, residual " << update);
     mrcpp::print::separator(3, '-');
-    auto update = 10.0, norm = 1.0;
+}
+
+int GPESolver::iterateReactionPotential(const mrcpp::ComplexFunction &V_vac, const Density &rho_el, double thrs, int max_it, double &update) {
+    if (this->history > 0 and this->kain == nullptr) {
+        this->kain = std::make_unique<KAIN>(this->history);
+        this->kain->setLocalPrintLevel(10);
+    }
+
+    auto norm = 1.0;
+    update = 10.0;
 
     auto iter = 1;
-    while (update >= this->conv_thrs && iter <= max_iter) {
+    while (update >= thrs && iter <= max_it) {
         Timer t_iter;
         // solve the poisson equation
         mrcpp::ComplexFunction V_tot;
@@ -185,8 +245,8 @@ void GPESolver::runMicroIterations(const mrcpp::ComplexFunction &V_vac, const De
         mrcpp::cplxfunc::add(dVr_n, 1.0, Vr_np1, -1.0, this->Vr_n, -1.0);
         update = dVr_n.norm();
 
-        if (iter > 1 and this->history > 0) {
-            accelerateConvergence(dVr_n, Vr_n, kain);
+        if (this->kain != nullptr) {
+            accelerateConvergence(dVr_n, Vr_n, *this->kain);
             Vr_np1.free(NUMBER::Real);
             mrcpp::cplxfunc::add(Vr_np1, 1.0, Vr_n, 1.0, dVr_n, -1.0);
         }
@@ -198,15 +258,10 @@ void GPESolver::runMicroIterations(const mrcpp::ComplexFunction &V_vac, const De
 
         printConvergenceRow(iter, norm, update, t_iter.elapsed());
 
-        // compute new PB term
-        if (update < this->conv_thrs) break;
+        if (update < thrs) break;
         iter++;
     }
-
-    if (iter > max_iter) println(0, "Reaction potential failed to converge after " << iter - 1 << " iterations, residual " << update);
-    mrcpp::print::separator(3, '-');
-
-    kain.clear();
+    return std::min(iter, max_it);
 }
 
 void GPESolver::printConvergenceRow(int i, double norm, double update, double time) const {
@@ -235,13 +290,12 @@ void GPESolver::printConvergenceRow(int i, double norm, double update, double ti
 
 mrcpp::ComplexFunction &GPESolver::solveEquation(double prec, const Density &rho_el) {
     this->apply_prec = prec;
+    setupDielectric(prec);
     Density rho_tot(false);
     computeDensities(rho_el, rho_tot);
     Timer t_vac;
-    mrcpp::ComplexFunction V_vac;
-    V_vac.alloc(NUMBER::Real);
-    mrcpp::apply(this->apply_prec, V_vac.real(), *poisson, rho_tot.real());
-    rho_tot.free(NUMBER::Real);
+    updateVacuumPotential(rho_tot);
+    auto &V_vac = this->V_vac;
     print_utils::qmfunction(3, "Vacuum potential", V_vac, t_vac);
 
     // set up the zero-th iteration potential and gamma, so the first iteration gamma and potentials can be made
@@ -65,6 +65,10 @@ enum class SCRFDensityType : int { TOTAL = 0, ELECTRONIC = 1, NUCLEAR = 2 };
  * the MO update of the previous SCF iteration, unless the MO update is small enough (once the quality of the MOs is good enough, we use the default convergence threshold).
  * Another optimization used is that we utilize the previous SCF converged Reaction potential as an initial guess for the next micro-iterations. These procedures are
  * investigated and explained in :cite:`gerez2023`
+ *
+ * The KAIN history of the micro-iterations is kept from one SCF iteration to the next, and the vacuum potential is updated
+ * from the change in the density since the previous call, rather than recomputed from the full density. Both are reset
+ * when the precision changes.
  */
 class GPESolver {
 public:
@@ -81,8 +85,8 @@ public:
     /** @brief Sets the convergence threshold for the micro-iterations, used with dynamic thresholding.
      *  @param prec value to set the convergence threshold to
      *  @return the current convergence threshold.
-     *  @details will check if the MO update is small enough (ten times as big) wrt. to the scf convergence threshold, if so, it will use the default convergence threshold.
-     * If not, it will use the MO update as the convergence threshold.
+     *  @details With dynamic thresholding the MO update is used as the convergence threshold, bounded from below by
+     * the precision and from above by 1.0. Otherwise the precision is used.
      */
     double setConvergenceThreshold(double prec);
 
@@ -131,11 +135,29 @@ protected:
 
     mrcpp::ComplexFunction Vr_n;
 
+    double vacuum_prec{-1.0};     ///< Precision of the stored vacuum potential, negative if not set up
+    Density rho_vac;              ///< Density used in the stored vacuum potential
+    mrcpp::ComplexFunction V_vac; ///< Vacuum potential of #rho_vac
+    std::unique_ptr<KAIN> kain;   ///< Micro-iteration accelerator, kept across SCF iterations
+
+    double dielectric_prec{-1.0};                 ///< Precision of the cached dielectric functions, negative if not set up
+    mrcpp::ComplexFunction eps_inv;               ///< Projected inverse permittivity \f$1/\epsilon(\mathbf{r})\f$
+    std::vector<mrcpp::ComplexFunction> d_cavity; ///< Projected cavity gradient \f$\nabla C(\mathbf{r})\f$
+
     std::shared_ptr<mrcpp::DerivativeOperator<3>> derivative;
     std::shared_ptr<mrcpp::PoissonOperator> poisson;
 
     void clear();
 
+    /** @brief Projects the dielectric functions needed in the micro-iterations
+     * @param prec the projection precision
+     * @details The cavity gradient and the inverse permittivity are analytic functions that stay
+     * fixed during the calculation. They are projected once and reused in all micro-iterations and
+     * SCF iterations, until they are requested at a different precision.
+     */
+    virtual void setupDielectric(double prec);
+    virtual void clearDielectric();
+
     /** @brief computes density wrt. the density_type variable
      * @param Phi the molecular orbitals
      * @param rho_out Density function in which the density will be computed.
@@ -195,7 +217,25 @@ protected:
      *  -# Update the reaction potential as \f$V_R(\mathbf{r}) = V_R^{old}(\mathbf{r}) + \Delta V_R(\mathbf{r})\f$
      *  -# Check if the reaction potential has converged, if not, repeat from step 1.
      */
-    void runMicroIterations(const mrcpp::ComplexFunction &V_vac, const Density &rho_el);
+    virtual void runMicroIterations(const mrcpp::ComplexFunction &V_vac, const Density &rho_el);
+
+    /** @brief Runs the micro-iterations of #runMicroIterations with a given threshold and iteration limit
+     * @param V_vac the vacuum potential
+     * @param rho_el the electronic density
+     * @param thrs convergence threshold for the update of the reaction potential
+     * @param max_it maximum number of iterations
+     * @param[out] update norm of the last update of the reaction potential
+     * @return the number of iterations performed
+     */
+    int iterateReactionPotential(const mrcpp::ComplexFunction &V_vac, const Density &rho_el, double thrs, int max_it, double &update);
+
+    /** @brief Updates the vacuum potential to the given density
+     * @param rho_tot the density defining the vacuum potential
+     * @details If a vacuum potential at the current precision is available, only the change in the density is
+     * passed through the Poisson operator: \f$V_{vac} \leftarrow V_{vac} + \mathcal{P} \star (\rho - \rho_{old})\f$.
+     * Otherwise the potential is computed from scratch and the KAIN history is cleared.
+     */
+    void updateVacuumPotential(const Density &rho_tot);
 
     /** @brief Setups and computes the reaction potential through the microiterations
      * @param V_vac the vacuum potential
@@ -58,7 +58,7 @@ LPBESolver::LPBESolver(const Permittivity &e,
 // TODO separate this for the linear and non-linear solver
 void LPBESolver::computePBTerm(mrcpp::ComplexFunction &V_tot, const double salt_factor, mrcpp::ComplexFunction &pb_term) {
     resetComplexFunction(pb_term);
-    mrcpp::cplxfunc::multiply(pb_term, V_tot, this->kappa, this->apply_prec);
+    mrcpp::cplxfunc::multiply(pb_term, V_tot, this->kappa_f, this->apply_prec);
     pb_term.rescale(salt_factor / (4.0 * mrcpp::pi));
 }
 
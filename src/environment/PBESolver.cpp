@@ -55,9 +55,45 @@ PBESolver::PBESolver(const Permittivity &e,
                      bool dyn_thrs,
                      SCRFDensityType density_type)
         : GPESolver(e, rho_nuc, P, D, kain_hist, max_iter, dyn_thrs, density_type)
-        , kappa(k) {}
+        , kappa(k)
+        , kappa_f(false)
+        , V_lin(false)
+        , pb_lin_0(false)
+        , pb_lin_1(false) {}
+
+void PBESolver::setNewton(int micro_iter, double eta) {
+    if (micro_iter < 1) MSG_ABORT("Invalid number of Newton micro-iterations");
+    this->newton_krylov = true;
+    this->krylov_iter = micro_iter;
+    this->newton_eta = eta;
+}
+
+void PBESolver::setupDielectric(double prec) {
+    if (this->dielectric_prec > 0.0 and std::abs(this->dielectric_prec - prec) < mrcpp::MachineZero) return;
+    GPESolver::setupDielectric(prec);
+
+    Timer timer;
+    this->kappa_f.free(NUMBER::Total);
+    mrcpp::cplxfunc::project(this->kappa_f, this->kappa, NUMBER::Real, prec);
+    print_utils::qmfunction(3, "DH screening function", this->kappa_f, timer);
+}
+
+void PBESolver::clearDielectric() {
+    this->kappa_f.free(NUMBER::Total);
+    GPESolver::clearDielectric();
+}
 
 void PBESolver::computePBTerm(mrcpp::ComplexFunction &V_tot, const double salt_factor, mrcpp::ComplexFunction &pb_term) {
+    if (this->V_lin.hasReal()) {
+        // linearized PB term: pb_0 + pb_1 * (V_tot - V_0)
+        mrcpp::ComplexFunction dV;
+        mrcpp::cplxfunc::add(dV, 1.0, V_tot, -1.0, this->V_lin, -1.0);
+        mrcpp::ComplexFunction lin_term;
+        mrcpp::cplxfunc::multiply(lin_term, dV, this->pb_lin_1, this->apply_prec);
+        resetComplexFunction(pb_term);
+        mrcpp::cplxfunc::add(pb_term, 1.0, this->pb_lin_0, 1.0, lin_term, -1.0);
+        return;
+    }
     // create a lambda function for the sinh(V) term and multiply it with kappa and salt factor to get the PB term
     auto sinh_f = [salt_factor](const double &V) { return (salt_factor / (4.0 * mrcpp::pi)) * std::sinh(V); };
     resetComplexFunction(pb_term);
@@ -65,29 +101,75 @@ void PBESolver::computePBTerm(mrcpp::ComplexFunction &V_tot, const double salt_f
     sinhV.alloc(NUMBER::Real);
     mrcpp::map(this->apply_prec / 100, sinhV.real(), V_tot.real(), sinh_f);
 
-    mrcpp::cplxfunc::multiply(pb_term, sinhV, this->kappa, this->apply_prec);
+    mrcpp::cplxfunc::multiply(pb_term, sinhV, this->kappa_f, this->apply_prec);
 }
 
-void PBESolver::computeGamma(mrcpp::ComplexFunction &potential, mrcpp::ComplexFunction &out_gamma) {
+void PBESolver::setLinearization(mrcpp::ComplexFunction &V_tot, double salt_factor) {
+    auto sinh_f = [salt_factor](const double &V) { return (salt_factor / (4.0 * mrcpp::pi)) * std::sinh(V); };
+    auto cosh_f = [salt_factor](const double &V) { return (salt_factor / (4.0 * mrcpp::pi)) * std::cosh(V); };
+
+    mrcpp::ComplexFunction sinhV;
+    sinhV.alloc(NUMBER::Real);
+    mrcpp::map(this->apply_prec / 100, sinhV.real(), V_tot.real(), sinh_f);
+    resetComplexFunction(this->pb_lin_0);
+    mrcpp::cplxfunc::multiply(this->pb_lin_0, sinhV, this->kappa_f, this->apply_prec);
 
-    auto d_V = mrcpp::gradient(*derivative, potential.real()); // FunctionTreeVector
-    resetComplexFunction(out_gamma);
-
-    for (int d = 0; d < 3; d++) {
-        auto C_pin = this->epsilon.getCavity_p();
-        mrcpp::AnalyticFunction<3> d_cav(C_pin->getGradVector()[d]);
-        mrcpp::ComplexFunction cplxfunc_prod;
-        mrcpp::cplxfunc::multiply(cplxfunc_prod, get_func(d_V, d), d_cav, this->apply_prec, 1);
-        // add result into out_gamma
-        if (d == 0) {
-            mrcpp::cplxfunc::deep_copy(out_gamma, cplxfunc_prod);
-        } else {
-            out_gamma.add(1.0, cplxfunc_prod);
-        }
+    mrcpp::ComplexFunction coshV;
+    coshV.alloc(NUMBER::Real);
+    mrcpp::map(this->apply_prec / 100, coshV.real(), V_tot.real(), cosh_f);
+    resetComplexFunction(this->pb_lin_1);
+    mrcpp::cplxfunc::multiply(this->pb_lin_1, coshV, this->kappa_f, this->apply_prec);
+
+    resetComplexFunction(this->V_lin);
+    mrcpp::cplxfunc::deep_copy(this->V_lin, V_tot);
+}
+
+void PBESolver::clearLinearization() {
+    this->V_lin.free(NUMBER::Total);
+    this->pb_lin_0.free(NUMBER::Total);
+    this->pb_lin_1.free(NUMBER::Total);
+}
+
+void PBESolver::runMicroIterations(const mrcpp::ComplexFunction &V_vac, const Density &rho_el) {
+    if (not this->newton_krylov) return GPESolver::runMicroIterations(V_vac, rho_el);
+
+    mrcpp::print::separator(3, '-');
+    auto salt_factor = 1.0; // placeholder for now, same as in computeGamma
+    auto update = 10.0;
+
+    auto iter = 1;
+    auto total_iter = 0;
+    while (update >= this->conv_thrs && total_iter < this->max_iter) {
+        mrcpp::ComplexFunction V_tot;
+        mrcpp::cplxfunc::add(V_tot, 1.0, this->Vr_n, 1.0, V_vac, -1.0);
+        setLinearization(V_tot, salt_factor);
+
+        mrcpp::ComplexFunction Vr_old;
+        mrcpp::cplxfunc::deep_copy(Vr_old, this->Vr_n);
+
+        // inexact Newton step. The first step keeps the KAIN history of the previous
+        // SCF iteration as a warm start, later steps change the linear problem and restart it
+        if (iter > 1 and this->kain != nullptr) this->kain->clear();
+        auto lin_thrs = std::max(this->conv_thrs, this->newton_eta * std::min(update, 1.0));
+        auto lin_max = std::min(this->krylov_iter, this->max_iter - total_iter);
+        auto lin_update = 0.0;
+        auto lin_iter = iterateReactionPotential(V_vac, rho_el, lin_thrs, lin_max, lin_update);
+        total_iter += lin_iter;
+        clearLinearization();
+
+        mrcpp::ComplexFunction dVr;
+        mrcpp::cplxfunc::add(dVr, 1.0, this->Vr_n, -1.0, Vr_old, -1.0);
+        update = dVr.norm();
+        println(3, " Newton step " << iter << " (" << lin_iter << " micro-iterations), update " << std::setprecision(5) << std::scientific << update);
+        iter++;
     }
 
-    out_gamma.rescale(std::log((epsilon.getValueIn() / epsilon.getValueOut())) * (1.0 / (4.0 * mrcpp::pi)));
-    mrcpp::clear(d_V, true);
+    if (update >= this->conv_thrs) println(0, "Poisson-Boltzmann Newton iterations failed to converge after " << iter - 1 << " steps (" << total_iter << " micro-iterations), residual " << update);
+    mrcpp::print::separator(3, '-');
+}
+
+void PBESolver::computeGamma(mrcpp::ComplexFunction &potential, mrcpp::ComplexFunction &out_gamma) {
+    GPESolver::computeGamma(potential, out_gamma);
 
     // add PB term
     mrcpp::ComplexFunction pb_term;
@@ -57,6 +57,16 @@ namespace mrchem {
  * \nabla^2 V_{R} = -4\pi\frac{1-\epsilon}{\epsilon}\left(\rho_{el} + \rho_{nuc}\right) + \gamma_s - \kappa^2 \sinh\left(V_{tot}\right)
  * \f]
  * where \f$\gamma_s\f$ is the surface charge density, \f$\kappa\f$ is obtained from the DHScreening class and \f$V_{R}\f$ is the reaction potential.
+ *
+ * By default the nonlinear equation is solved with the fixed-point micro-iterations of GPESolver. With setNewton()
+ * it is instead solved with an inexact Newton method. In each Newton step the sinh term is linearized around the
+ * current total potential \f$V_0\f$,
+ * \f[
+ * \kappa^2 \sinh\left(V_{tot}\right) \approx \kappa^2 \sinh\left(V_0\right) + \kappa^2 \cosh\left(V_0\right)\left(V_{tot} - V_0\right),
+ * \f]
+ * and the resulting linear equation is solved approximately by a few Poisson-preconditioned micro-iterations with
+ * KAIN acceleration, to a tolerance proportional to the previous Newton update. The micro-iterations of all Newton
+ * steps together are limited by the max_iter of the fixed-point solver.
  */
 class PBESolver : public GPESolver {
 public:
@@ -70,10 +80,24 @@ public:
               bool dyn_thrs,
               SCRFDensityType density_type);
 
+    /** @brief Use inexact Newton steps for the nonlinear equation
+     * @param micro_iter max micro-iterations in each Newton step
+     * @param eta relative convergence threshold of each Newton step
+     */
+    void setNewton(int micro_iter, double eta);
+
     friend class ReactionPotential;
 
 protected:
-    DHScreening kappa; ///< the DHScreening object used to compute the PB term \f$\kappa\f$
+    DHScreening kappa;              ///< the DHScreening object used to compute the PB term \f$\kappa\f$
+    mrcpp::ComplexFunction kappa_f; ///< Projected DHScreening function, cached together with the dielectric functions
+
+    bool newton_krylov{false};       ///< Solve the nonlinear equation with inexact Newton steps
+    int krylov_iter{5};              ///< Max micro-iterations per Newton step
+    double newton_eta{0.1};          ///< Relative tolerance of each Newton step
+    mrcpp::ComplexFunction V_lin;    ///< Total potential at the linearization point
+    mrcpp::ComplexFunction pb_lin_0; ///< PB term at the linearization point
+    mrcpp::ComplexFunction pb_lin_1; ///< Derivative of the PB term at the linearization point
     std::string solver_name{"Poisson-Boltzmann"};
 
     /** @brief constructs the surface chage distribution and adds it to the PB term
@@ -83,6 +107,12 @@ protected:
      */
     void computeGamma(mrcpp::ComplexFunction &potential, mrcpp::ComplexFunction &out_gamma) override;
 
+    /** @brief Projects the dielectric functions and the DHScreening function
+     * @param prec the projection precision
+     */
+    void setupDielectric(double prec) override;
+    void clearDielectric() override;
+
     /** @brief Computes the PB term
      * @param[in] V_tot the total potential
      * @param[in] salt_factor the salt factor deciding how much of the total concentration to include in the PB term
@@ -90,5 +120,20 @@ protected:
      * @details The PB term is computed as \f$ \kappa^2 \sinh(V_{tot}) \f$ and returned.
      */
     virtual void computePBTerm(mrcpp::ComplexFunction &V_tot, const double salt_factor, mrcpp::ComplexFunction &pb_term);
+
+    /** @brief Solves for the reaction potential with inexact Newton steps
+     * @param V_vac the vacuum potential
+     * @param rho_el the electronic density
+     * @details Falls back to the fixed-point micro-iterations of GPESolver if #newton_krylov is false.
+     */
+    void runMicroIterations(const mrcpp::ComplexFunction &V_vac, const Density &rho_el) override;
+
+    /** @brief Linearizes the PB term around the given total potential
+     * @param V_tot the linearization point
+     * @param salt_factor the salt factor of the PB term
+     * @details While a linearization is set, #computePBTerm returns \f$ pb_0 + pb_1 (V_{tot} - V_0)\f$.
+     */
+    void setLinearization(mrcpp::ComplexFunction &V_tot, double salt_factor);
+    void clearLinearization();
 };
 } // namespace mrchem
@@ -28,6 +28,13 @@
 #include <MRCPP/Printer>
 #include <MRCPP/Timer>
 
+#include <array>
+#include <memory>
+
+#ifdef MRCHEM_HAS_OMP
+#include <omp.h>
+#endif
+
 #include "core.h"
 
 #include "analyticfunctions/HydrogenFunction.h"
@@ -71,6 +78,9 @@ int PT[29][2] = {
 };
 // clang-format on
 
+ComplexMatrix calc_screened_overlap(OrbitalVector &Bra, OrbitalVector &Ket, const std::vector<std::pair<int, int>> &pairs);
+std::vector<std::pair<int, int>> get_overlapping_pairs(const std::vector<AOSupport> &support);
+
 } // namespace core
 } // namespace initial_guess
 
@@ -111,7 +121,8 @@ bool initial_guess::core::setup(OrbitalVector &Phi, double prec, const Nuclei &n
     // Project AO basis of hydrogen functions
     t_lap.start();
     OrbitalVector Psi;
-    initial_guess::core::project_ao(Psi, prec, nucs, zeta);
+    std::vector<AOSupport> support;
+    initial_guess::core::project_ao(Psi, prec, nucs, zeta, &support);
     if (plevel == 1) mrcpp::print::time(1, "Projecting Hydrogen AOs", t_lap);
 
     p.setup(prec);
@@ -120,7 +131,7 @@ bool initial_guess::core::setup(OrbitalVector &Phi, double prec, const Nuclei &n
     // Compute Hamiltonian matrix
     t_lap.start();
     mrcpp::print::header(2, "Diagonalize Hamiltonian matrix");
-    ComplexMatrix U = initial_guess::core::diagonalize(Psi, p, V);
+    ComplexMatrix U = initial_guess::core::diagonalize(Psi, p, V, support);
 
     // Rotate orbitals and fill electrons by Aufbau
     auto Phi_a = orbital::disjoin(Phi, SPIN::Alpha);
@@ -160,7 +171,7 @@ bool initial_guess::core::setup(OrbitalVector &Phi, double prec, const Nuclei &n
  * QZ: 1s2s2p3s3p4s3d4p5s4d5p (5s + 12p + 10d)
  *
  */
-void initial_guess::core::project_ao(OrbitalVector &Phi, double prec, const Nuclei &nucs, int zeta) {
+void initial_guess::core::project_ao(OrbitalVector &Phi, double prec, const Nuclei &nucs, int zeta, std::vector<AOSupport> *support) {
     Timer t_tot;
     auto w0 = Printer::getWidth() - 2;
     auto w1 = 5;
@@ -182,6 +193,11 @@ void initial_guess::core::project_ao(OrbitalVector &Phi, double prec, const Nucl
 
     const char label[10] = "spdfg";
 
+    // Collect the AOs of all atoms, then project them in parallel
+    std::vector<std::unique_ptr<HydrogenFunction>> h_funcs;
+    std::vector<std::string> h_labels;
+    std::vector<std::array<int, 2>> h_nl;
+    std::vector<int> h_atoms;
     for (int i = 0; i < nucs.size(); i++) {
         const Nucleus &nuc = nucs[i];
         int minAO = std::ceil(nuc.getElement().getZ() / 2.0);
@@ -201,29 +217,113 @@ void initial_guess::core::project_ao(OrbitalVector &Phi, double prec, const Nucl
             if (zetaReached >= zeta) break;
 
             for (int m = 0; m < M; m++) {
-                Timer t_i;
-                HydrogenFunction h_func(n, l, m, Z, R);
-                Phi.push_back(Orbital(SPIN::Paired));
-                Phi.back().setRank(Phi.size() - 1);
-                if (mrcpp::mpi::my_orb(Phi.back())) {
-                    mrcpp::cplxfunc::project(Phi.back(), h_func, NUMBER::Real, prec);
-                    if (std::abs(Phi.back().norm() - 1.0) > 0.01) MSG_WARN("AO not normalized!");
-                }
-
-                std::stringstream o_txt;
-                o_txt << std::setw(w1 - 1) << Phi.size() - 1;
-                o_txt << std::setw(w4) << nuc.getElement().getSymbol();
-                o_txt << std::setw(w2 - 1) << n << label[l];
-                print_utils::qmfunction(2, o_txt.str(), Phi.back(), t_i);
+                h_funcs.push_back(std::make_unique<HydrogenFunction>(n, l, m, Z, R));
+                h_labels.push_back(std::to_string(n) + label[l]);
+                h_nl.push_back({n, l});
+                h_atoms.push_back(i);
 
                 if (++nAO >= minAO) minAOReached = true;
             }
             nShell++;
         }
     }
+
+    int first = Phi.size();
+    OrbitalVector Psi;
+    std::vector<mrcpp::RepresentableFunction<3> *> funcs;
+    for (auto &h_func : h_funcs) {
+        Psi.push_back(Orbital(SPIN::Paired));
+        Psi.back().setRank(first + Psi.size() - 1);
+        funcs.push_back(h_func.get());
+    }
+    std::vector<Timer> timers(Psi.size());
+    initial_guess::core::project_functions(Psi, prec, funcs, timers);
+
+    for (int i = 0; i < Psi.size(); i++) {
+        if (mrcpp::mpi::my_orb(Psi[i]) and std::abs(Psi[i].norm() - 1.0) > 0.01) MSG_WARN("AO not normalized!");
+
+        std::stringstream o_txt;
+        o_txt << std::setw(w1 - 1) << first + i;
+        o_txt << std::setw(w4) << nucs[h_atoms[i]].getElement().getSymbol();
+        o_txt << std::setw(w2 - 1) << h_labels[i];
+        print_utils::qmfunction(2, o_txt.str(), Psi[i], timers[i]);
+
+        if (support != nullptr) {
+            const Nucleus &nuc = nucs[h_atoms[i]];
+            double radius = initial_guess::core::calc_ao_radius(h_nl[i][0], h_nl[i][1], nuc.getCharge(), 0.1 * prec);
+            support->push_back({nuc.getCoord(), radius});
+        }
+        Phi.push_back(Psi[i]);
+    }
     mrcpp::print::footer(2, t_tot, 2);
 }
 
+/** @brief Project analytic AOs onto the MW basis, one OpenMP thread per AO
+ *
+ * @param Phi: output orbitals, same size as funcs
+ * @param prec: precision used in projection
+ * @param funcs: analytic AO functions
+ * @param timers: projection time of each AO, same size as funcs
+ *
+ * Only the orbitals owned by this MPI rank are projected. Nested parallelism is
+ * disabled for the duration, so that MRCPP runs serially within each AO.
+ */
+void initial_guess::core::project_functions(OrbitalVector &Phi, double prec, std::vector<mrcpp::RepresentableFunction<3> *> &funcs, std::vector<Timer> &timers) {
+    std::vector<int> my_idx;
+    for (int i = 0; i < Phi.size(); i++) {
+        if (mrcpp::mpi::my_orb(Phi[i])) my_idx.push_back(i);
+    }
+    int n_my = my_idx.size();
+
+#ifdef MRCHEM_HAS_OMP
+    int n_threads = std::max(1, std::min(mrcpp::omp::n_threads, n_my));
+    int max_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(1);
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads)
+#endif
+    for (int k = 0; k < n_my; k++) {
+        int i = my_idx[k];
+        timers[i].start();
+        mrcpp::cplxfunc::project(Phi[i], *funcs[i], NUMBER::Real, prec);
+        timers[i].stop();
+    }
+#ifdef MRCHEM_HAS_OMP
+    omp_set_max_active_levels(max_levels);
+#endif
+}
+
+/** @brief Radius beyond which a radially decaying function is below a threshold
+ *
+ * @param f: radial bound of the function, |phi(r)| <= f(|r|)
+ * @param thrs: threshold for the function value
+ *
+ * The bound is scanned inwards from 100 bohr with a relative step of 3%.
+ */
+double initial_guess::core::calc_radial_extent(const std::function<double(double)> &f, double thrs) {
+    double step = 0.97;
+    for (double r = 100.0; r > 1.0e-2; r *= step) {
+        if (f(r) > thrs) return r / step;
+    }
+    return 0.0;
+}
+
+/** @brief Radius beyond which a hydrogen AO is below a threshold
+ *
+ * @param n: principal quantum number
+ * @param l: angular momentum quantum number
+ * @param Z: nuclear charge
+ * @param thrs: threshold for the AO value
+ *
+ * Uses the analytic radial function R_nl and the largest value of a real
+ * spherical harmonic of order l, sqrt((2l + 1) / 4pi).
+ */
+double initial_guess::core::calc_ao_radius(int n, int l, double Z, double thrs) {
+    RadialFunction R(n, l, Z);
+    double y_max = std::sqrt((2.0 * l + 1.0) / (4.0 * mrcpp::pi));
+    auto bound = [&R, y_max](double r) { return y_max * std::abs(R.evalf({r})); };
+    return initial_guess::core::calc_radial_extent(bound, thrs);
+}
+
 void initial_guess::core::rotate_orbitals(OrbitalVector &Psi, double prec, ComplexMatrix &U, OrbitalVector &Phi) {
     if (Psi.size() == 0) return;
     Timer t_tot;
@@ -231,12 +331,98 @@ void initial_guess::core::rotate_orbitals(OrbitalVector &Psi, double prec, Compl
     mrcpp::print::time(1, "Rotating orbitals", t_tot);
 }
 
-ComplexMatrix initial_guess::core::diagonalize(OrbitalVector &Phi, MomentumOperator &p, RankZeroOperator &V) {
+/** @brief Pairs of AOs (i <= j) whose supports overlap */
+std::vector<std::pair<int, int>> initial_guess::core::get_overlapping_pairs(const std::vector<AOSupport> &support) {
+    std::vector<std::pair<int, int>> pairs;
+    for (int i = 0; i < support.size(); i++) {
+        for (int j = i; j < support.size(); j++) {
+            double dist = math_utils::calc_distance(support[i].center, support[j].center);
+            if (dist < support[i].radius + support[j].radius) pairs.push_back({i, j});
+        }
+    }
+    return pairs;
+}
+
+/** @brief Hermitian matrix S_ij = <bra_i|ket_j>, computed only for the given pairs
+ *
+ * All other elements are zero. Without MPI the pairs are computed in parallel
+ * by OpenMP. With MPI the full matrix is computed by the blocked MPI overlap,
+ * which sends each orbital a limited number of times, and then masked with the
+ * pair list, so that the result is the same as in the serial case. Sending the
+ * bra of every single pair would be far more communication than that.
+ */
+ComplexMatrix initial_guess::core::calc_screened_overlap(OrbitalVector &Bra, OrbitalVector &Ket, const std::vector<std::pair<int, int>> &pairs) {
+    int N = Bra.size();
+    int n_pairs = pairs.size();
+    ComplexVector S_ij = ComplexVector::Zero(n_pairs);
+
+    if (mrcpp::mpi::wrk_size > 1) {
+        ComplexMatrix S_full = orbital::calc_overlap_matrix(Bra, Ket);
+        for (int k = 0; k < n_pairs; k++) S_ij(k) = S_full(pairs[k].first, pairs[k].second);
+    } else {
+#ifdef MRCHEM_HAS_OMP
+        int max_levels = omp_get_max_active_levels();
+        omp_set_max_active_levels(1);
+#pragma omp parallel for schedule(dynamic) num_threads(mrcpp::omp::n_threads)
+#endif
+        for (int k = 0; k < n_pairs; k++) S_ij(k) = orbital::dot(Bra[pairs[k].first], Ket[pairs[k].second]);
+#ifdef MRCHEM_HAS_OMP
+        omp_set_max_active_levels(max_levels);
+#endif
+    }
+
+    ComplexMatrix S = ComplexMatrix::Zero(N, N);
+    for (int k = 0; k < n_pairs; k++) {
+        S(pairs[k].first, pairs[k].second) = S_ij(k);
+        S(pairs[k].second, pairs[k].first) = std::conj(S_ij(k));
+    }
+    return S;
+}
+
+/** @brief Compute and diagonalize the Fock matrix in the AO basis
+ *
+ * @param Phi: AO basis
+ * @param p: momentum operator
+ * @param V: potential operator
+ * @param support: AO centers and radii, enables screening of the AO matrices
+ *
+ * With screening, only matrix elements between AOs with overlapping support are
+ * computed. Without support information the full matrices are computed.
+ */
+ComplexMatrix initial_guess::core::diagonalize(OrbitalVector &Phi, MomentumOperator &p, RankZeroOperator &V, const std::vector<AOSupport> &support) {
     Timer t1;
-    ComplexMatrix S_m12 = orbital::calc_lowdin_matrix(Phi);
-    mrcpp::print::separator(2, '-');
-    ComplexMatrix t_tilde = qmoperator::calc_kinetic_matrix(p, Phi, Phi);
-    ComplexMatrix v_tilde = V(Phi, Phi);
+    ComplexMatrix S_m12, t_tilde, v_tilde;
+    bool screen = (support.size() == Phi.size());
+    if (not screen) print_utils::text(2, "Screened AO pairs", "skipped, no AO support");
+    if (screen) {
+        auto pairs = initial_guess::core::get_overlapping_pairs(support);
+        int N = Phi.size();
+        print_utils::text(2, "Screened AO pairs", std::to_string(pairs.size()) + " / " + std::to_string(N * (N + 1) / 2));
+
+        Timer t_s;
+        ComplexMatrix S_tilde = initial_guess::core::calc_screened_overlap(Phi, Phi, pairs);
+        mrcpp::print::time(2, "Computing overlap matrix", t_s);
+        S_m12 = math_utils::hermitian_matrix_pow(S_tilde, -1.0 / 2.0);
+        mrcpp::print::separator(2, '-');
+
+        Timer t_t;
+        t_tilde = ComplexMatrix::Zero(N, N);
+        for (int d = 0; d < 3; d++) {
+            OrbitalVector dPhi = p[d](Phi);
+            t_tilde += 0.5 * initial_guess::core::calc_screened_overlap(dPhi, dPhi, pairs);
+        }
+        mrcpp::print::time(2, "Computing kinetic matrix", t_t);
+
+        Timer t_v;
+        OrbitalVector VPhi = V(Phi);
+        v_tilde = initial_guess::core::calc_screened_overlap(Phi, VPhi, pairs);
+        mrcpp::print::time(2, "Computing potential matrix", t_v);
+    } else {
+        S_m12 = orbital::calc_lowdin_matrix(Phi);
+        mrcpp::print::separator(2, '-');
+        t_tilde = qmoperator::calc_kinetic_matrix(p, Phi, Phi);
+        v_tilde = V(Phi, Phi);
+    }
     ComplexMatrix f_tilde = t_tilde + v_tilde;
     ComplexMatrix f = S_m12.adjoint() * f_tilde * S_m12;
     mrcpp::print::separator(2, '-');
@@ -25,6 +25,11 @@
 
 #pragma once
 
+#include <functional>
+#include <vector>
+
+#include <MRCPP/Timer>
+
 #include "mrchem.h"
 #include "qmfunctions/qmfunction_fwd.h"
 #include "tensor/tensor_fwd.h"
@@ -45,10 +50,22 @@ class Nuclei;
 namespace initial_guess {
 namespace core {
 
+/** @brief Center and radius of the region where an AO is non-negligible
+ *
+ * Used to skip matrix elements between AOs that do not overlap.
+ */
+struct AOSupport {
+    mrcpp::Coord<3> center;
+    double radius;
+};
+
 bool setup(OrbitalVector &Phi, double prec, const Nuclei &nucs, int zeta);
-void project_ao(OrbitalVector &Phi, double prec, const Nuclei &nucs, int zeta);
+void project_ao(OrbitalVector &Phi, double prec, const Nuclei &nucs, int zeta, std::vector<AOSupport> *support = nullptr);
+void project_functions(OrbitalVector &Phi, double prec, std::vector<mrcpp::RepresentableFunction<3> *> &funcs, std::vector<mrcpp::Timer> &timers);
+double calc_radial_extent(const std::function<double(double)> &f, double thrs);
+double calc_ao_radius(int n, int l, double Z, double thrs);
 void rotate_orbitals(OrbitalVector &Psi, double prec, ComplexMatrix &U, OrbitalVector &Phi);
-ComplexMatrix diagonalize(OrbitalVector &Phi, MomentumOperator &T, RankZeroOperator &V);
+ComplexMatrix diagonalize(OrbitalVector &Phi, MomentumOperator &T, RankZeroOperator &V, const std::vector<AOSupport> &support = {});
 
 } // namespace core
 } // namespace initial_guess
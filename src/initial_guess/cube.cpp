@@ -26,12 +26,17 @@
 #include "cube.h"
 
 #include <fstream>
+#include <memory>
 
 #include <MRCPP/MWFunctions>
 #include <MRCPP/Printer>
 #include <MRCPP/Timer>
 #include <nlohmann/json.hpp>
 
+#ifdef MRCHEM_HAS_OMP
+#include <omp.h>
+#endif
+
 #include "analyticfunctions/CUBEfunction.h"
 #include "qmfunctions/Orbital.h"
 #include "qmfunctions/orbital_utils.h"
@@ -47,19 +52,20 @@ namespace mrchem {
 namespace initial_guess {
 namespace cube {
 
-bool project_mo(OrbitalVector &Phi, double prec, const std::string &mo_file);
-std::vector<mrchem::CUBEfunction> getCUBEFunction(const json &json_cube);
+bool project_mo(OrbitalVector &Phi, double prec, const std::string &mo_file, bool tricubic);
+std::vector<std::unique_ptr<mrchem::CUBEfunction>> getCUBEFunction(const json &json_cube, const OrbitalVector &Phi, bool tricubic);
 
 } // namespace cube
 } // namespace initial_guess
 
-bool initial_guess::cube::setup(OrbitalVector &Phi, double prec, const std::string &file_p, const std::string &file_a, const std::string &file_b) {
+bool initial_guess::cube::setup(OrbitalVector &Phi, double prec, const std::string &file_p, const std::string &file_a, const std::string &file_b, bool tricubic) {
     if (Phi.size() == 0) return false;
 
     mrcpp::print::separator(0, '~');
     print_utils::text(0, "Calculation   ", "Compute initial orbitals");
     print_utils::text(0, "Method        ", "Project cube file molecular orbitals");
     print_utils::text(0, "Precision     ", print_utils::dbl_to_str(prec, 5, true));
+    print_utils::text(0, "Interpolation ", (tricubic) ? "Tricubic" : "Trilinear");
     if (orbital::size_singly(Phi)) {
         print_utils::text(0, "Restricted    ", "False");
         print_utils::text(0, "MO alpha file ", file_a);
@@ -76,9 +82,9 @@ bool initial_guess::cube::setup(OrbitalVector &Phi, double prec, const std::stri
 
     // Project paired, alpha and beta separately
     auto success = true;
-    success &= initial_guess::cube::project_mo(Phi, prec, file_p);
-    success &= initial_guess::cube::project_mo(Phi_a, prec, file_a);
-    success &= initial_guess::cube::project_mo(Phi_b, prec, file_b);
+    success &= initial_guess::cube::project_mo(Phi, prec, file_p, tricubic);
+    success &= initial_guess::cube::project_mo(Phi_a, prec, file_a, tricubic);
+    success &= initial_guess::cube::project_mo(Phi_b, prec, file_b, tricubic);
 
     // Collect orbitals into one vector
     Phi = orbital::adjoin(Phi, Phi_a);
@@ -87,7 +93,12 @@ bool initial_guess::cube::setup(OrbitalVector &Phi, double prec, const std::stri
     return success;
 }
 
-bool initial_guess::cube::project_mo(OrbitalVector &Phi, double prec, const std::string &mo_file) {
+/** @brief Project the orbitals of one cube vector file
+ *
+ * Only the grids of the orbitals owned by this MPI rank are kept in memory,
+ * and these orbitals are projected with one OpenMP thread per orbital.
+ */
+bool initial_guess::cube::project_mo(OrbitalVector &Phi, double prec, const std::string &mo_file, bool tricubic) {
     if (Phi.size() == 0) return true;
 
     Timer t_tot;
@@ -113,28 +124,55 @@ bool initial_guess::cube::project_mo(OrbitalVector &Phi, double prec, const std:
     ifs >> cube_inp;
     ifs.close();
 
-    auto CUBEVector = initial_guess::cube::getCUBEFunction(cube_inp);
+    auto CUBEVector = initial_guess::cube::getCUBEFunction(cube_inp, Phi, tricubic);
+    cube_inp.clear();
 
-    bool success = true;
+    std::vector<int> my_idx;
     for (int i = 0; i < Phi.size(); i++) {
-        Timer t_i;
         if (mrcpp::mpi::my_orb(Phi[i])) {
-            CUBEfunction phi_i = CUBEVector[i];
             Phi[i].alloc(NUMBER::Real);
-            mrcpp::project(prec, Phi[i].real(), phi_i);
-            std::stringstream o_txt;
-            o_txt << std::setw(w1 - 1) << i;
-            o_txt << std::setw(w3) << print_utils::dbl_to_str(Phi[i].norm(), pprec, true);
-            print_utils::qmfunction(1, o_txt.str(), Phi[i], t_i);
+            my_idx.push_back(i);
         }
     }
+    int n_my = my_idx.size();
+    std::vector<Timer> timers(Phi.size());
+
+#ifdef MRCHEM_HAS_OMP
+    int n_threads = std::max(1, std::min(mrcpp::omp::n_threads, n_my));
+    int max_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(1);
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads)
+#endif
+    for (int k = 0; k < n_my; k++) {
+        int i = my_idx[k];
+        timers[i].start();
+        mrcpp::project(prec, Phi[i].real(), *CUBEVector[i]);
+        timers[i].stop();
+        CUBEVector[i].reset();
+    }
+#ifdef MRCHEM_HAS_OMP
+    omp_set_max_active_levels(max_levels);
+#endif
+
+    bool success = true;
+    for (int i : my_idx) {
+        std::stringstream o_txt;
+        o_txt << std::setw(w1 - 1) << i;
+        o_txt << std::setw(w3) << print_utils::dbl_to_str(Phi[i].norm(), pprec, true);
+        print_utils::qmfunction(1, o_txt.str(), Phi[i], timers[i]);
+    }
     mrcpp::mpi::barrier(mrcpp::mpi::comm_wrk);
     mrcpp::print::footer(1, t_tot, 2);
     return success;
 }
 
-std::vector<mrchem::CUBEfunction> initial_guess::cube::getCUBEFunction(const json &json_cube) {
-    std::vector<mrchem::CUBEfunction> CUBEVector;
+/** @brief Build the interpolating functions of the cube file orbitals
+ *
+ * Entries are only created for the orbitals in Phi owned by this MPI rank,
+ * the others are left empty.
+ */
+std::vector<std::unique_ptr<mrchem::CUBEfunction>> initial_guess::cube::getCUBEFunction(const json &json_cube, const OrbitalVector &Phi, bool tricubic) {
+    std::vector<std::unique_ptr<mrchem::CUBEfunction>> CUBEVector;
     for (const auto &item : json_cube.items()) {
         auto Header = item.value()["Header"];
         auto N_atoms = Header["N_atoms"];
@@ -146,13 +184,20 @@ std::vector<mrchem::CUBEfunction> initial_guess::cube::getCUBEFunction(const jso
         auto atom_coords = Header["atom_coords"];
         auto N_vals = Header["N_vals"];
         for (const auto &value : item.value()["CUBE_data"].items()) {
+            int i = CUBEVector.size();
+            if (i >= Phi.size() or not mrcpp::mpi::my_orb(Phi[i])) {
+                CUBEVector.push_back(nullptr);
+                continue;
+            }
             // the data is saved as a vector of vectors indexing as
             // CUBE_data[ID][x_val*n_steps[1]*n_steps[2] + y_val*n_steps[2] + z_val]
-            auto CUBE_data = value.value();
-            mrchem::CUBEfunction single_cube(N_atoms, N_vals, N_steps, origin, Voxel_axes, Z_n, CUBE_data, atom_charges, atom_coords);
-            CUBEVector.push_back(single_cube);
+            const auto &CUBE_data = value.value();
+            CUBEVector.push_back(std::make_unique<mrchem::CUBEfunction>(N_atoms, N_vals, N_steps, origin, Voxel_axes, Z_n, CUBE_data, atom_charges, atom_coords, tricubic));
         }
     }
+    for (int i = 0; i < Phi.size(); i++) {
+        if (mrcpp::mpi::my_orb(Phi[i]) and (i >= CUBEVector.size() or CUBEVector[i] == nullptr)) MSG_ABORT("Missing cube data for orbital " << i);
+    }
 
     return CUBEVector;
 }
@@ -28,6 +28,11 @@
 #include <MRCPP/Printer>
 #include <MRCPP/Timer>
 
+#include <algorithm>
+#include <map>
+#include <memory>
+
+#include "core.h"
 #include "gto.h"
 
 #include "utils/gto_utils/Intgrl.h"
@@ -47,6 +52,12 @@ using mrcpp::Timer;
 
 namespace mrchem {
 
+namespace initial_guess {
+namespace gto {
+double calc_ao_radius(const GaussExp<3> &ao, double thrs);
+} // namespace gto
+} // namespace initial_guess
+
 /** @brief Produce an initial guess of orbitals
  *
  * @param Phi: vector or MW orbitals
@@ -173,11 +184,13 @@ void initial_guess::gto::project_mo(OrbitalVector &Phi, double prec, const std::
  * @param prec Precision used in projection
  * @param bas_file String containing basis set file
  * @param screen GTO screening in StdDev
+ * @param support: optional output of AO centers and radii, used for screening
  *
  * Projects the N first Gaussian-type AOs into corresponding MW orbitals.
+ * The basis of each element is read once, and the AOs are projected in parallel.
  *
  */
-void initial_guess::gto::project_ao(OrbitalVector &Phi, double prec, const Nuclei &nucs, double screen) {
+void initial_guess::gto::project_ao(OrbitalVector &Phi, double prec, const Nuclei &nucs, double screen, std::vector<initial_guess::core::AOSupport> *support) {
     Timer timer;
     auto w0 = Printer::getWidth() - 2;
     auto w1 = 5;
@@ -199,46 +212,67 @@ void initial_guess::gto::project_ao(OrbitalVector &Phi, double prec, const Nucle
 
     const char label[10] = "spdfg";
 
-    for (const auto &nuc : nucs) {
-        std::string sad_path;
-        for (auto n : {sad_basis_source_dir(), sad_basis_install_dir()}) {
-            auto trimmed = print_utils::rtrim_copy(n);
-            if (mrcpp::details::directory_exists(trimmed)) {
-                sad_path = trimmed;
-                break;
-            }
+    std::string sad_path;
+    for (auto n : {sad_basis_source_dir(), sad_basis_install_dir()}) {
+        auto trimmed = print_utils::rtrim_copy(n);
+        if (mrcpp::details::directory_exists(trimmed)) {
+            sad_path = trimmed;
+            break;
         }
+    }
+
+    // Collect the AOs of all atoms, reading each element's basis only once
+    std::map<std::string, std::unique_ptr<gto_utils::Intgrl>> basis;
+    std::vector<GaussExp<3>> ao_exps;
+    std::vector<int> ao_atoms;
+    for (int k = 0; k < nucs.size(); k++) {
+        const Nucleus &nuc = nucs[k];
         const std::string &sym = nuc.getElement().getSymbol();
-        std::stringstream o_bas;
-        o_bas << sad_path << "/" << sym << ".bas";
+        if (basis.find(sym) == basis.end()) {
+            std::stringstream o_bas;
+            o_bas << sad_path << "/" << sym << ".bas";
+            basis[sym] = std::make_unique<gto_utils::Intgrl>(o_bas.str());
+        }
 
         // Setup AO basis
-        gto_utils::Intgrl intgrl(o_bas.str());
+        gto_utils::Intgrl &intgrl = *basis[sym];
         intgrl.getNucleus(0).setCoord(nuc.getCoord());
         gto_utils::OrbitalExp gto_exp(intgrl);
 
-        int n = 0;
         for (int i = 0; i < gto_exp.size(); i++) {
-            Timer t_i;
-            Phi.push_back(Orbital(SPIN::Paired));
-            Phi.back().setRank(Phi.size() - 1);
-            GaussExp<3> ao_i = gto_exp.getAO(i);
-            ao_i.calcScreening(screen);
-            if (mrcpp::mpi::my_orb(Phi.back())) {
-                mrcpp::cplxfunc::project(Phi.back(), ao_i, NUMBER::Real, prec);
-                if (std::abs(Phi.back().norm() - 1.0) > 0.01) MSG_WARN("AO not normalized!");
-            }
-
-            auto l = ao_i.getPower(0);
-            auto L = l[0] + l[1] + l[2];
-
-            std::stringstream o_txt;
-            o_txt << std::setw(w1 - 1) << Phi.size();
-            o_txt << std::setw(w4) << nuc.getElement().getSymbol();
-            o_txt << std::setw(w2 - 1) << label[L];
-            print_utils::qmfunction(2, o_txt.str(), Phi.back(), t_i);
+            ao_exps.push_back(gto_exp.getAO(i));
+            ao_exps.back().calcScreening(screen);
+            ao_atoms.push_back(k);
         }
     }
+
+    int first = Phi.size();
+    OrbitalVector Psi;
+    std::vector<mrcpp::RepresentableFunction<3> *> funcs;
+    for (auto &ao_i : ao_exps) {
+        Psi.push_back(Orbital(SPIN::Paired));
+        Psi.back().setRank(first + Psi.size() - 1);
+        funcs.push_back(&ao_i);
+    }
+    std::vector<Timer> timers(Psi.size());
+    initial_guess::core::project_functions(Psi, prec, funcs, timers);
+
+    for (int i = 0; i < Psi.size(); i++) {
+        if (mrcpp::mpi::my_orb(Psi[i]) and std::abs(Psi[i].norm() - 1.0) > 0.01) MSG_WARN("AO not normalized!");
+
+        auto l = ao_exps[i].getPower(0);
+        auto L = l[0] + l[1] + l[2];
+
+        const Nucleus &nuc = nucs[ao_atoms[i]];
+        std::stringstream o_txt;
+        o_txt << std::setw(w1 - 1) << first + i + 1;
+        o_txt << std::setw(w4) << nuc.getElement().getSymbol();
+        o_txt << std::setw(w2 - 1) << label[L];
+        print_utils::qmfunction(2, o_txt.str(), Psi[i], timers[i]);
+
+        if (support != nullptr) support->push_back({nuc.getCoord(), initial_guess::gto::calc_ao_radius(ao_exps[i], 0.1 * prec)});
+        Phi.push_back(Psi[i]);
+    }
     mrcpp::mpi::barrier(mrcpp::mpi::comm_wrk);
     timer.stop();
     mrcpp::print::footer(2, timer, 2);
@@ -260,6 +294,29 @@ Density initial_guess::gto::project_density(double prec, const Nucleus &nuc, con
     return rho;
 }
 
+/** @brief Radius beyond which a contracted Gaussian AO is below a threshold
+ *
+ * @param ao: the AO
+ * @param thrs: threshold for the AO value
+ *
+ * Each primitive c * x^a y^b z^c * exp(-alpha r^2) is bounded by
+ * |c| * r^(a + b + c) * exp(-alpha r^2), using the smallest exponent.
+ */
+double initial_guess::gto::calc_ao_radius(const GaussExp<3> &ao, double thrs) {
+    auto bound = [&ao](double r) {
+        double val = 0.0;
+        for (int i = 0; i < ao.size(); i++) {
+            const auto &gto = ao.getFunc(i);
+            auto alpha = gto.getExp();
+            auto pow = gto.getPower();
+            double a_min = *std::min_element(alpha.begin(), alpha.end());
+            val += std::abs(gto.getCoef()) * std::pow(r, pow[0] + pow[1] + pow[2]) * std::exp(-a_min * r * r);
+        }
+        return val;
+    };
+    return initial_guess::core::calc_radial_extent(bound, thrs);
+}
+
 } // namespace mrchem
 
 // void OrbitalVector::readVirtuals(const string &bf, const string &mo, int n_occ) {
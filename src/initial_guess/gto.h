@@ -26,7 +26,9 @@
 #pragma once
 
 #include <string>
+#include <vector>
 
+#include "core.h"
 #include "qmfunctions/qmfunction_fwd.h"
 
 /** @file gto.h
@@ -61,7 +63,8 @@ void project_mo(OrbitalVector &Phi,
 void project_ao(OrbitalVector &Phi,
                 double prec,
                 const Nuclei &nucs,
-                double screen = -1.0);
+                double screen = -1.0,
+                std::vector<core::AOSupport> *support = nullptr);
 Density project_density(double prec,
                         const Nucleus &nuc,
                         const std::string &bas_file,
@@ -23,18 +23,25 @@
  * <https://mrchem.readthedocs.io/>
  */
 
+#include <MRCPP/Gaussians>
 #include <MRCPP/MWOperators>
 #include <MRCPP/Parallel>
 #include <MRCPP/Printer>
 #include <MRCPP/Timer>
 #include <MRCPP/utils/details.h>
 
+#include <map>
+#include <memory>
+
 #include "core.h"
 #include "gto.h"
 #include "sad.h"
 
 #include "chemistry/Nucleus.h"
 
+#include "utils/gto_utils/Intgrl.h"
+#include "utils/gto_utils/OrbitalExp.h"
+#include "utils/math_utils.h"
 #include "utils/print_utils.h"
 
 #include "qmfunctions/Orbital.h"
@@ -48,6 +55,7 @@
 
 #include "mrdft/Factory.h"
 
+using mrcpp::GaussExp;
 using mrcpp::Printer;
 using mrcpp::Timer;
 
@@ -110,7 +118,8 @@ bool initial_guess::sad::setup(OrbitalVector &Phi, double prec, double screen, c
     // Project AO basis of hydrogen functions
     t_lap.start();
     OrbitalVector Psi;
-    initial_guess::core::project_ao(Psi, prec, nucs, zeta);
+    std::vector<initial_guess::core::AOSupport> support;
+    initial_guess::core::project_ao(Psi, prec, nucs, zeta, &support);
     if (plevel == 1) mrcpp::print::time(1, "Projecting Hydrogen AOs", t_lap);
 
     if (plevel == 2) mrcpp::print::header(2, "Building Fock operator");
@@ -122,7 +131,7 @@ bool initial_guess::sad::setup(OrbitalVector &Phi, double prec, double screen, c
 
     // Compute Fock matrix
     mrcpp::print::header(2, "Diagonalizing Fock matrix");
-    ComplexMatrix U = initial_guess::core::diagonalize(Psi, p, V);
+    ComplexMatrix U = initial_guess::core::diagonalize(Psi, p, V, support);
 
     // Rotate orbitals and fill electrons by Aufbau
     t_lap.start();
@@ -188,7 +197,8 @@ bool initial_guess::sad::setup(OrbitalVector &Phi, double prec, double screen, c
     // Project AO basis of hydrogen functions
     t_lap.start();
     OrbitalVector Psi;
-    initial_guess::gto::project_ao(Psi, prec, nucs);
+    std::vector<initial_guess::core::AOSupport> support;
+    initial_guess::gto::project_ao(Psi, prec, nucs, -1.0, &support);
     if (plevel == 1) mrcpp::print::time(1, "Projecting GTO AOs", t_lap);
     if (plevel == 2) mrcpp::print::header(2, "Building Fock operator");
     t_lap.start();
@@ -199,7 +209,7 @@ bool initial_guess::sad::setup(OrbitalVector &Phi, double prec, double screen, c
 
     // Compute Fock matrix
     mrcpp::print::header(2, "Diagonalizing Fock matrix");
-    ComplexMatrix U = initial_guess::core::diagonalize(Psi, p, V);
+    ComplexMatrix U = initial_guess::core::diagonalize(Psi, p, V, support);
 
     // Rotate orbitals and fill electrons by Aufbau
     t_lap.start();
@@ -249,26 +259,55 @@ void initial_guess::sad::project_atomic_densities(double prec, Density &rho_tot,
 
     Timer t_tot;
     Density rho_loc(false);
-    rho_loc.alloc(NUMBER::Real);
-    rho_loc.real().setZero();
+
+    // The basis and density matrix files are parsed once per element, and
+    // the GTO densities of all local atoms are projected as one expansion
+    struct AtomicData {
+        std::unique_ptr<gto_utils::Intgrl> basis{nullptr};
+        DoubleMatrix D;
+        double charge{0.0};
+    };
+    std::map<std::string, AtomicData> atomic_data;
 
     Timer t_loc;
     auto N_nucs = nucs.size();
     DoubleVector charges = DoubleVector::Zero(2 * N_nucs);
+    GaussExp<3> dens_loc;
     for (int k = 0; k < N_nucs; k++) {
         if (mrcpp::mpi::wrk_rank != k % mrcpp::mpi::wrk_size) continue;
 
         const std::string &sym = nucs[k].getElement().getSymbol();
-        std::stringstream o_bas, o_dens;
-        o_bas << sad_path << "/" << sym << ".bas";
-        o_dens << sad_path << "/" << sym << ".dens";
-
-        Density rho_k = initial_guess::gto::project_density(prec, nucs[k], o_bas.str(), o_dens.str(), screen);
-        rho_loc.add(1.0, rho_k);
-        rho_loc.crop(crop_prec);
+        auto &data = atomic_data[sym];
+        bool first = (data.basis == nullptr);
+        if (first) {
+            std::stringstream o_bas, o_dens;
+            o_bas << sad_path << "/" << sym << ".bas";
+            o_dens << sad_path << "/" << sym << ".dens";
+            data.basis = std::make_unique<gto_utils::Intgrl>(o_bas.str());
+            data.D = math_utils::read_matrix_file(o_dens.str());
+        }
+        data.basis->getNucleus(0).setCoord(nucs[k].getCoord());
+        gto_utils::OrbitalExp gto_exp(*data.basis);
+        GaussExp<3> dens_k = gto_exp.getDens(data.D);
+        if (first) {
+            // Electron charge of the atomic density, same for all atoms of this element
+            dens_k.calcScreening(screen);
+            Density rho_k(false);
+            density::compute(prec, rho_k, dens_k);
+            data.charge = rho_k.integrate().real();
+        }
+        dens_loc.append(dens_k);
 
         charges[k] = nucs[k].getCharge();
-        charges[N_nucs + k] = rho_k.integrate().real();
+        charges[N_nucs + k] = data.charge;
+    }
+    if (dens_loc.size() > 0) {
+        dens_loc.calcScreening(screen);
+        density::compute(prec, rho_loc, dens_loc);
+        rho_loc.crop(crop_prec);
+    } else {
+        rho_loc.alloc(NUMBER::Real);
+        rho_loc.real().setZero();
     }
     t_loc.stop();
     Timer t_com;
@@ -30,6 +30,8 @@
 
 #include "mrchem.h"
 #include "mrenv.h"
+#include "qmfunctions/density_utils.h"
+#include "tensor/RankZeroOperator.h"
 #include "utils/print_utils.h"
 #include "version.h"
 
@@ -126,8 +128,39 @@ void mrenv::init_mra(const json &json_mra) {
     mrcpp::cplxfunc::SetdefaultMRA(MRA);
 }
 
+/** @brief Create an MRA like the global one, but with another polynomial order
+ *
+ * The world box, basis type and max depth are taken from the global MRA.
+ * The caller takes ownership of the returned MRA.
+ */
+mrcpp::MultiResolutionAnalysis<3> *mrenv::create_mra(int order) {
+    if (MRA == nullptr) MSG_ABORT("Global MRA not initialized");
+    const auto &world = MRA->getWorldBox();
+    auto max_depth = MRA->getMaxDepth();
+    if (MRA->getScalingBasis().getScalingType() == mrcpp::Interpol) {
+        mrcpp::InterpolatingBasis basis(order);
+        return new mrcpp::MultiResolutionAnalysis<3>(world, basis, max_depth);
+    } else {
+        mrcpp::LegendreBasis basis(order);
+        return new mrcpp::MultiResolutionAnalysis<3>(world, basis, max_depth);
+    }
+}
+
+/** @brief Replace the global MRA
+ *
+ * Functions and operators that are created after this call use the new MRA.
+ * Existing ones keep the MRA they were built with. The global MRA that is
+ * deleted in finalize() must be restored before that.
+ */
+void mrenv::set_mra(mrcpp::MultiResolutionAnalysis<3> *mra) {
+    MRA = mra;
+    mrcpp::cplxfunc::SetdefaultMRA(MRA);
+}
+
 void mrenv::init_mpi(const json &json_mpi) {
     mrcpp::mpi::numerically_exact = json_mpi["numerically_exact"];
+    density::reduce_by_nodes = json_mpi["reduce_by_nodes"];
+    RankZeroOperator::omp_orbital_nodes = json_mpi["omp_orbital_nodes"];
     mrcpp::mpi::shared_memory_size = json_mpi["shared_memory_size"];
     mrcpp::mpi::bank_size = json_mpi["bank_size"];
     mrcpp::mpi::omp_threads = json_mpi["omp_threads"];
@@ -29,6 +29,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include "mrchem.h"
+
 namespace mrchem {
 namespace mrenv {
 
@@ -38,6 +40,9 @@ void dump_json(const nlohmann::json &json_inp, const nlohmann::json &json_out);
 void initialize(const nlohmann::json &json_inp);
 void finalize(double wt);
 
+mrcpp::MultiResolutionAnalysis<3> *create_mra(int order);
+void set_mra(mrcpp::MultiResolutionAnalysis<3> *mra);
+
 } // namespace mrenv
 namespace detail {
 std::string remove_extension(const std::string &fname);
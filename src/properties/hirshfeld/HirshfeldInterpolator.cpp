@@ -15,6 +15,21 @@ double HirshfeldRadInterpolater::getNorm() const {
     return norm;
 }
 
+double HirshfeldRadInterpolater::getCutoffRadius(double charge) const {
+    // Integrate the tail inwards from well beyond the tabulated grid,
+    // where the log density is extrapolated linearly
+    double dr = 0.01;
+    double r = 60.0;
+    double tail = 0.0;
+    while (r > dr) {
+        double r_mid = r - 0.5 * dr;
+        tail += 4 * M_PI * std::exp(evalf(r_mid)) * r_mid * r_mid * dr;
+        if (tail > charge) break;
+        r -= dr;
+    }
+    return r;
+}
+
 // Constructor
 HirshfeldRadInterpolater::HirshfeldRadInterpolater(const std::string element, std::string data_dir, bool writeToFile) {
     Eigen::VectorXd rGrid;
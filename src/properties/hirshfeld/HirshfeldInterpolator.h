@@ -27,6 +27,12 @@ public:
      */
     double getNorm() const;
 
+    /**
+     * @brief Radius beyond which the atomic density holds less than the given charge.
+     * @param charge The electronic charge allowed outside the radius
+     */
+    double getCutoffRadius(double charge) const;
+
 protected:
     /**
      * @brief The interpolator for the atomic density
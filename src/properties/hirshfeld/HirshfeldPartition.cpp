@@ -1,7 +1,10 @@
 #include "HirshfeldPartition.h"
 #include "utils/math_utils.h"
 
-HirshfeldPartition::HirshfeldPartition(const mrchem::Molecule &mol, std::string data_dir) {
+#include <algorithm>
+#include <limits>
+
+HirshfeldPartition::HirshfeldPartition(const mrchem::Molecule &mol, std::string data_dir, double prec) {
 
     this->nucs = std::make_shared<mrchem::Nuclei>(mol.getNuclei());
     this->nNucs = this->nucs->size();
@@ -11,7 +14,10 @@ HirshfeldPartition::HirshfeldPartition(const mrchem::Molecule &mol, std::string
         this->logDensities.push_back(HirshfeldRadInterpolater(element, data_dir));
         // Uncomment the following line to print the charge of the atomic density
         // std::cout << "Norm of " << element << " = " << this->logDensities[i].getNorm() << std::endl;
+        this->cutoffs.push_back(this->logDensities[i].getCutoffRadius(0.1 * prec));
+        this->maxCutoff = std::max(this->maxCutoff, this->cutoffs[i]);
     }
+    this->nucList = mrchem::CellList(*this->nucs, this->maxCutoff);
 
 }
 
@@ -29,23 +35,22 @@ double HirshfeldPartition::getHirshfeldPartitionIntegral(int index, mrcpp::Compl
 }
 
 double HirshfeldPartition::lseLogDens(const mrcpp::Coord<3> &r) const {
-    Eigen::VectorXd lseLogDens_r(this->nNucs);
-    double rr;
-    mrcpp::Coord<3> nucPos;
-    for (int i = 0; i < this->nNucs; i++) {
-        nucPos = this->nucs->at(i).getCoord();
-        rr = std::sqrt((r[0] - nucPos[0]) * (r[0] - nucPos[0])
-            + (r[1] - nucPos[1]) * (r[1] - nucPos[1])
-            + (r[2] - nucPos[2]) * (r[2] - nucPos[2]));
-        lseLogDens_r(i) = this->logDensities[i].evalf(rr);
-    }
-    return mrchem::math_utils::logsumexp(lseLogDens_r);
+    // Only atoms within their cutoff radius contribute, two passes to avoid allocation
+    double max = -std::numeric_limits<double>::max();
+    this->nucList.forEachCandidate(r, this->maxCutoff, [this, &r, &max](int i) {
+        double rr = mrchem::math_utils::calc_distance(r, this->nucs->at(i).getCoord());
+        if (rr < this->cutoffs[i]) max = std::max(max, this->logDensities[i].evalf(rr));
+    });
+    double sum = 0.0;
+    this->nucList.forEachCandidate(r, this->maxCutoff, [this, &r, &sum, max](int i) {
+        double rr = mrchem::math_utils::calc_distance(r, this->nucs->at(i).getCoord());
+        if (rr < this->cutoffs[i]) sum += std::exp(this->logDensities[i].evalf(rr) - max);
+    });
+    return max + std::log(sum);
 }
 
 double HirshfeldPartition::evalf(const mrcpp::Coord<3> &r, int iAt) const {
-    mrcpp::Coord<3> nucPos = this->nucs->at(iAt).getCoord();
-    double rr = std::sqrt((r[0] - nucPos[0]) * (r[0] - nucPos[0])
-        + (r[1] - nucPos[1]) * (r[1] - nucPos[1])
-        + (r[2] - nucPos[2]) * (r[2] - nucPos[2]));
+    double rr = mrchem::math_utils::calc_distance(r, this->nucs->at(iAt).getCoord());
+    if (rr >= this->cutoffs[iAt]) return 0.0;
     return std::exp(this->logDensities[iAt].evalf(rr) - this->lseLogDens(r));
-}
\ No newline at end of file
+}
@@ -2,6 +2,7 @@
 
 #include <Eigen/Dense>
 #include <mrchem.h>
+#include "chemistry/CellList.h"
 #include "chemistry/Molecule.h"
 #include <string>
 #include "chemistry/Nucleus.h"
@@ -18,8 +19,9 @@ class HirshfeldPartition{
      * @brief Construct a new Hirshfeld Partition object
      * @param mol The molecule for which the Hirshfeld partitioning is to be computed
      * @param data_dir The directory containing the Hirshfeld partitioning data
+     * @param prec Precision used to truncate the tails of the atomic densities
      */
-    HirshfeldPartition(const mrchem::Molecule &mol, std::string data_dir);
+    HirshfeldPartition(const mrchem::Molecule &mol, std::string data_dir, double prec);
 
     /**
      * @brief Get the integral rho * w_i for a given atom i
@@ -53,5 +55,20 @@ class HirshfeldPartition{
      */
     std::vector<HirshfeldRadInterpolater> logDensities;
 
+    /**
+     * @brief Radius beyond which each atomic density is neglected
+     */
+    std::vector<double> cutoffs;
+
+    /**
+     * @brief The largest of the cutoff radii
+     */
+    double maxCutoff{0.0};
+
+    /**
+     * @brief Spatial index over the nuclei, used to find the atoms within their cutoff of a point
+     */
+    mrchem::CellList nucList;
+
 
 };
\ No newline at end of file
@@ -28,6 +28,7 @@
 #include "MRCPP/Timer"
 #include "MRCPP/Parallel"
 #include "MRCPP/MWFunctions"
+#include "MRCPP/trees/FunctionNode.h"
 
 #include "Density.h"
 #include "Orbital.h"
@@ -48,10 +49,13 @@ extern mrcpp::MultiResolutionAnalysis<3> *MRA; // Global MRA
  ****************************************/
 
 namespace density {
+bool reduce_by_nodes = false;
 Density compute(double prec, Orbital phi, DensityType spin);
 void compute_local_X(double prec, Density &rho, OrbitalVector &Phi, OrbitalVector &X, DensityType spin);
 void compute_local_XY(double prec, Density &rho, OrbitalVector &Phi, OrbitalVector &X, OrbitalVector &Y, DensityType spin);
 double compute_occupation(Orbital &phi, DensityType dens_spin);
+void reduce_densities(double prec, std::vector<Density> &rho);
+void broadcast_densities(std::vector<Density> &rho);
 } // namespace density
 
 /** @brief Compute density as the square of an orbital
@@ -108,6 +112,32 @@ void density::compute(double prec, Density &rho, OrbitalVector &Phi, DensityType
     density::allreduce_density(abs_prec, rho, rho_loc);
 }
 
+/** @brief Compute several spin densities in a single pass over the orbitals
+ *
+ * @param[in] prec Precision
+ * @param[out] rho Densities to compute, one for each entry in spin
+ * @param[in] Phi Orbitals defining the densities
+ * @param[in] spin Which spin density (total, spin, alpha, beta) goes into each rho
+ *
+ * Each orbital is squared only once and its contribution is added with the
+ * appropriate occupation into all requested densities.
+ *
+ * MPI: Each rank first computes its own local densities, which are then reduced
+ *      and broadcasted to all ranks together, see allreduce_density.
+ *
+ */
+void density::compute(double prec, std::vector<Density *> &rho, OrbitalVector &Phi, const std::vector<DensityType> &spin) {
+    if (rho.size() != spin.size()) MSG_ERROR("Size mismatch");
+    int N_el = orbital::get_electron_number(Phi);
+    double rel_prec = prec;        // prec for rho_i = |phi_i|^2
+    double abs_prec = prec / N_el; // prec for rho = sum_i rho_i
+
+    std::vector<Density> rho_loc;
+    for (int k = 0; k < static_cast<int>(rho.size()); k++) rho_loc.emplace_back(false);
+    density::compute_local(rel_prec, rho_loc, Phi, spin);
+    density::allreduce_density(abs_prec, rho, rho_loc);
+}
+
 /** @brief Compute transition density as rho = sum_i |x_i><phi_i| + |phi_i><y_i|
  *
  * MPI: Each rank first computes its own local density, which is then reduced
@@ -149,6 +179,40 @@ void density::compute_local(double prec, Density &rho, OrbitalVector &Phi, Densi
     }
 }
 
+/** @brief Compute several local spin densities as the sum of own (MPI) orbitals
+ *
+ * The orbital density |phi_i|^2 is computed once (with total occupation) and
+ * then scaled into each of the requested spin densities.
+ */
+void density::compute_local(double prec, std::vector<Density> &rho, OrbitalVector &Phi, const std::vector<DensityType> &spin) {
+    if (rho.size() != spin.size()) MSG_ERROR("Size mismatch");
+    int N_el = orbital::get_electron_number(Phi);
+    double abs_prec = (mrcpp::mpi::numerically_exact) ? -1.0 : prec / N_el;
+
+    for (auto &rho_k : rho) {
+        if (not rho_k.hasReal()) rho_k.alloc(NUMBER::Real);
+        if (rho_k.hasReal()) rho_k.real().setZero();
+        if (rho_k.hasImag()) rho_k.imag().setZero();
+    }
+
+    for (auto &phi_i : Phi) {
+        if (mrcpp::mpi::my_orb(phi_i)) {
+            // Each orbital has a single spin, so a vanishing total
+            // occupation implies vanishing occupation for all spins
+            double occ_t = density::compute_occupation(phi_i, DensityType::Total);
+            if (std::abs(occ_t) < mrcpp::MachineZero) continue;
+
+            Density rho_i = density::compute(prec, phi_i, DensityType::Total);
+            for (int k = 0; k < static_cast<int>(rho.size()); k++) {
+                double occ_k = density::compute_occupation(phi_i, spin[k]);
+                if (std::abs(occ_k) < mrcpp::MachineZero) continue;
+                rho[k].add(occ_k / occ_t, rho_i); // Extends to union grid
+                rho[k].crop(abs_prec);            // Truncates to given precision
+            }
+        }
+    }
+}
+
 /** @brief Compute local density as the sum of own (MPI) orbitals
  */
 void density::compute_local(double prec, Density &rho, OrbitalVector &Phi, OrbitalVector &X, OrbitalVector &Y, DensityType spin) {
@@ -242,6 +306,13 @@ double density::compute_occupation(Orbital &phi, DensityType dens_spin) {
  *
  */
 void density::allreduce_density(double prec, Density &rho_tot, Density &rho_loc) {
+    if (density::reduce_by_nodes) {
+        std::vector<mrcpp::ComplexFunction *> out = {&rho_tot};
+        std::vector<mrcpp::ComplexFunction *> inp = {&rho_loc};
+        density::allreduce_nodes(prec, out, inp);
+        return;
+    }
+
     // For numerically identical results in MPI we must first add
     // up orbital contributions onto their union grid, and THEN
     // crop the resulting density tree to the desired precision
@@ -275,6 +346,209 @@ void density::allreduce_density(double prec, Density &rho_tot, Density &rho_loc)
     }
 }
 
+/** @brief Add up several local density contributions and broadcast
+ *
+ * MPI: With node reduction all densities are summed in a single collective
+ *      operation. Otherwise all densities are reduced together to rank = 0
+ *      along one binary tree, where each step passes the whole set of
+ *      densities, and are then broadcasted to all ranks the same way.
+ *
+ */
+void density::allreduce_density(double prec, std::vector<Density *> &rho_tot, std::vector<Density> &rho_loc) {
+    if (rho_tot.size() != rho_loc.size()) MSG_ERROR("Size mismatch");
+    if (density::reduce_by_nodes) {
+        std::vector<mrcpp::ComplexFunction *> out(rho_tot.begin(), rho_tot.end());
+        std::vector<mrcpp::ComplexFunction *> inp;
+        for (auto &rho_k : rho_loc) inp.push_back(&rho_k);
+        density::allreduce_nodes(prec, out, inp);
+        return;
+    }
+    int nFuncs = rho_loc.size();
+
+    // See the single density version regarding numerically exact results
+    double part_prec = (mrcpp::mpi::numerically_exact) ? -1.0 : prec;
+    density::reduce_densities(part_prec, rho_loc);
+    if (mrcpp::mpi::grand_master()) {
+        if (mrcpp::mpi::numerically_exact) {
+            for (auto &rho_k : rho_loc) rho_k.crop(prec);
+        }
+    }
+
+    for (auto *rho_k : rho_tot) {
+        if (not rho_k->hasReal()) rho_k->alloc(NUMBER::Real);
+    }
+
+    bool shared = (nFuncs > 0) and rho_tot[0]->isShared();
+    if (shared) {
+        int tag = 2002;
+        for (int k = 0; k < nFuncs; k++) {
+            if (mrcpp::mpi::share_master()) {
+                // MPI grand master distributes to shared masters
+                mrcpp::mpi::broadcast_function(rho_loc[k], mrcpp::mpi::comm_sh_group);
+                // MPI shared masters copies the function into final memory
+                mrcpp::copy_grid(rho_tot[k]->real(), rho_loc[k].real());
+                mrcpp::copy_func(rho_tot[k]->real(), rho_loc[k].real());
+            }
+            // MPI share masters distributes to their sharing ranks
+            mrcpp::mpi::share_function(*rho_tot[k], 0, tag + k, mrcpp::mpi::comm_share);
+        }
+    } else {
+        // MPI grand master distributes to all ranks
+        density::broadcast_densities(rho_loc);
+        // All MPI ranks copies the functions into final memory
+        for (int k = 0; k < nFuncs; k++) {
+            mrcpp::copy_grid(rho_tot[k]->real(), rho_loc[k].real());
+            mrcpp::copy_func(rho_tot[k]->real(), rho_loc[k].real());
+        }
+    }
+}
+
+/** @brief Add up a set of local densities onto rank = 0
+ *
+ * Same binary tree as mrcpp::mpi::reduce_function, but each send/receive
+ * step handles the whole set of densities, so the number of communication
+ * rounds does not grow with the number of densities.
+ *
+ * 1) Each odd rank sends all its densities to the left rank
+ * 2) All odd ranks are done
+ * 3) New "effective" ranks are defined within the remaining ranks,
+ *    effective rank = rank/fac, where fac are powers of 2
+ * 4) Repeat
+ */
+void density::reduce_densities(double prec, std::vector<Density> &rho) {
+    int rank = mrcpp::mpi::wrk_rank;
+    int size = mrcpp::mpi::wrk_size;
+    if (size == 1) return;
+
+    int fac = 1; // powers of 2
+    while (fac < size) {
+        if ((rank / fac) % 2 == 0) {
+            int src = rank + fac;
+            if (src < size) {
+                int tag = 3333 + src;
+                for (auto &rho_k : rho) {
+                    Density rho_i(false);
+                    mrcpp::mpi::recv_function(rho_i, src, tag, mrcpp::mpi::comm_wrk);
+                    rho_k.add(1.0, rho_i); // add in place using union grid
+                    rho_k.crop(prec);
+                }
+            }
+        }
+        if ((rank / fac) % 2 == 1) {
+            int dst = rank - fac;
+            if (dst >= 0) {
+                int tag = 3333 + rank;
+                for (auto &rho_k : rho) mrcpp::mpi::send_function(rho_k, dst, tag, mrcpp::mpi::comm_wrk);
+                break; // once data is sent we are done
+            }
+        }
+        fac *= 2;
+    }
+}
+
+/** @brief Distribute a set of densities from rank = 0 to all ranks
+ *
+ * Reverse of reduce_densities: in each step every rank that already holds
+ * the densities sends the whole set to the rank fac steps to the right.
+ */
+void density::broadcast_densities(std::vector<Density> &rho) {
+    int rank = mrcpp::mpi::wrk_rank;
+    int size = mrcpp::mpi::wrk_size;
+    if (size == 1) return;
+
+    int fac = 1; // largest power of 2 below size
+    while (2 * fac < size) fac *= 2;
+    for (; fac > 0; fac /= 2) {
+        if (rank % (2 * fac) == 0 and rank + fac < size) {
+            int tag = 4444 + rank + fac;
+            for (auto &rho_k : rho) mrcpp::mpi::send_function(rho_k, rank + fac, tag, mrcpp::mpi::comm_wrk);
+        } else if (rank % (2 * fac) == fac) {
+            int tag = 4444 + rank;
+            for (auto &rho_k : rho) {
+                rho_k.free(NUMBER::Total);
+                mrcpp::mpi::recv_function(rho_k, rank - fac, tag, mrcpp::mpi::comm_wrk);
+            }
+        }
+    }
+}
+
+/** @brief Add up local function contributions node by node and distribute
+ *
+ * @param[in] prec Precision used to crop the final functions
+ * @param[out] out Reduced functions, identical on all ranks
+ * @param[in] inp Local function contributions
+ *
+ * Alternative to the tree based reduce + broadcast for real functions like
+ * densities and potentials:
+ *
+ * 1) All ranks agree on a common grid, the union of all local grids. Only
+ *    the tree structure is exchanged, not the coefficients.
+ * 2) Each local contribution is transferred onto the common grid, which is
+ *    exact since the common grid is a refinement of the local one.
+ * 3) The end node coefficients of all the functions are collected in one
+ *    contiguous vector and summed in a single MPI_Allreduce.
+ * 4) The output functions are assembled on the common grid on all ranks,
+ *    followed by a bottom-up transform and a crop to the requested precision.
+ *
+ * MPI: Requires the same number of functions on all ranks. For shared
+ *      functions the share masters assemble the result in shared memory.
+ *
+ */
+void density::allreduce_nodes(double prec, std::vector<mrcpp::ComplexFunction *> &out, std::vector<mrcpp::ComplexFunction *> &inp) {
+    if (out.size() != inp.size()) MSG_ERROR("Size mismatch");
+    int nFuncs = inp.size();
+    if (nFuncs == 0) return;
+
+    // 1) Agree on the union grid of all local contributions
+    FunctionTree<3> grid(*MRA);
+    for (auto *f_k : inp) {
+        if (f_k->hasImag()) MSG_ERROR("Node reduction only implemented for real functions");
+        if (f_k->hasReal()) grid.appendTreeNoCoeff(f_k->real());
+    }
+    mrcpp::mpi::reduce_Tree_noCoeff(grid, mrcpp::mpi::comm_wrk);
+    mrcpp::mpi::broadcast_Tree_noCoeff(grid, mrcpp::mpi::comm_wrk);
+
+    // 2) Transfer local contributions to the common grid and collect end node coefs
+    int nNodes = grid.getNEndNodes();
+    int nCoefs = (1 << grid.getDim()) * grid.getKp1_d();
+    DoubleVector coefs = DoubleVector::Zero(nFuncs * nNodes * nCoefs);
+    for (int k = 0; k < nFuncs; k++) {
+        if (not inp[k]->hasReal()) continue;
+        FunctionTreeVector<3> inp_vec;
+        inp_vec.push_back(std::make_tuple(1.0, &inp[k]->real()));
+
+        FunctionTree<3> f_k(*MRA);
+        mrcpp::copy_grid(f_k, grid);
+        mrcpp::add(-1.0, f_k, inp_vec, 0);
+        for (int n = 0; n < nNodes; n++) {
+            const double *c_n = f_k.getEndFuncNode(n).getCoefs();
+            for (int i = 0; i < nCoefs; i++) coefs((k * nNodes + n) * nCoefs + i) = c_n[i];
+        }
+    }
+
+    // 3) Sum all coefficients in one go
+    mrcpp::mpi::allreduce_vector(coefs, mrcpp::mpi::comm_wrk);
+
+    // 4) Assemble the reduced functions on the common grid
+    for (int k = 0; k < nFuncs; k++) {
+        mrcpp::ComplexFunction &f_out = *out[k];
+        if (not f_out.hasReal()) f_out.alloc(NUMBER::Real);
+        if (not(f_out.isShared()) or mrcpp::mpi::share_master()) {
+            FunctionTree<3> &tree = f_out.real();
+            mrcpp::copy_grid(tree, grid);
+            for (int n = 0; n < nNodes; n++) {
+                auto &node = tree.getEndFuncNode(n);
+                double *c_n = node.getCoefs();
+                for (int i = 0; i < nCoefs; i++) c_n[i] = coefs((k * nNodes + n) * nCoefs + i);
+                node.calcNorms();
+            }
+            tree.mwTransform(mrcpp::BottomUp);
+            tree.calcSquareNorm();
+            if (prec > 0.0) f_out.crop(prec);
+        }
+        if (f_out.isShared()) mrcpp::mpi::share_function(f_out, 0, 2003, mrcpp::mpi::comm_share);
+    }
+}
 
 // Function to read atomic density data from a file
 void density::readAtomicDensity(const std::string path, Eigen::VectorXd &rGrid, Eigen::VectorXd &rhoGrid) {
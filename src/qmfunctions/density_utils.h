@@ -32,11 +32,21 @@
 namespace mrchem {
 namespace density {
 
+/** Use node coefficient MPI_Allreduce (allreduce_nodes) instead of tree reduce
+ *  + broadcast. Set from the MPI section of the input in mrenv::init_mpi. Besides
+ *  all allreduce_density calls, this also switches the reduction of the local
+ *  potential in CoulombPotential::allreducePotential. */
+extern bool reduce_by_nodes;
+
+void allreduce_nodes(double prec, std::vector<mrcpp::ComplexFunction *> &out, std::vector<mrcpp::ComplexFunction *> &inp);
 void allreduce_density(double prec, Density &rho_tot, Density &rho_loc);
+void allreduce_density(double prec, std::vector<Density *> &rho_tot, std::vector<Density> &rho_loc);
 void compute(double prec, Density &rho, mrcpp::GaussExp<3> &dens_exp);
 void compute(double prec, Density &rho, OrbitalVector &Phi, DensityType spin);
 void compute(double prec, Density &rho, OrbitalVector &Phi, OrbitalVector &X, OrbitalVector &Y, DensityType spin);
+void compute(double prec, std::vector<Density *> &rho, OrbitalVector &Phi, const std::vector<DensityType> &spin);
 void compute_local(double prec, Density &rho, OrbitalVector &Phi, DensityType spin);
+void compute_local(double prec, std::vector<Density> &rho, OrbitalVector &Phi, const std::vector<DensityType> &spin);
 void compute_local(double prec, Density &rho, OrbitalVector &Phi, OrbitalVector &X, OrbitalVector &Y, DensityType spin);
 
 /**
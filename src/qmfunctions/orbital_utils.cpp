@@ -50,6 +50,10 @@ namespace orbital {
 ComplexMatrix localize(double prec, OrbitalVector &Phi, int spin);
 ComplexMatrix calc_localization_matrix(double prec, OrbitalVector &Phi);
 
+/* Above this number of orbitals the Foster-Boys functional is maximized by
+ * Jacobi sweeps instead of the second order method over all N(N-1)/2 angles. */
+constexpr int jacobi_localization_limit = 100;
+
 /* POD struct for orbital meta data. Used for simple MPI communication. */
 struct OrbitalData {
     int rank_id;
@@ -322,6 +326,31 @@ OrbitalVector orbital::param_copy(const OrbitalVector &Phi) {
     return out;
 }
 
+/** @brief Projection onto the current global MRA
+ *
+ * New orbitals are projected from the input set onto the global MRA,
+ * which may differ in polynomial order from the MRA of the input set.
+ * Used to move orbitals between the stages of a multilevel optimization.
+ *
+ */
+OrbitalVector orbital::reproject(double prec, OrbitalVector &Phi) {
+    Timer t_tot;
+    OrbitalVector out = orbital::param_copy(Phi);
+    for (int i = 0; i < Phi.size(); i++) {
+        if (not mrcpp::mpi::my_orb(Phi[i])) continue;
+        if (Phi[i].hasReal()) {
+            out[i].alloc(NUMBER::Real);
+            mrcpp::project(prec, out[i].real(), Phi[i].real());
+        }
+        if (Phi[i].hasImag()) {
+            out[i].alloc(NUMBER::Imag);
+            mrcpp::project(prec, out[i].imag(), Phi[i].imag());
+        }
+    }
+    mrcpp::print::time(1, "Projecting orbitals onto new MRA", t_tot);
+    return out;
+}
+
 /** @brief Adjoin two vectors
  *
  * The orbitals of the input vector are appended to
@@ -730,14 +759,24 @@ ComplexMatrix orbital::localize(double prec, OrbitalVector &Phi, ComplexMatrix &
 @param Phi_s: Orbital vector containig orbitals with given spin (p/a/b)
 
 Localization is done for each set of spins separately (we don't want to mix spins when localizing).
-The localization matrix is returned for further processing.
+The localization matrix is returned for further processing. If no element of the rotation
+differs from the identity by more than the precision, i.e. the orbitals are already localized
+and orthonormal (typically the case in the late SCF iterations, where the previous localization
+is carried over in the orbitals), the rotation is skipped and the identity is returned. The test
+is element-wise, so that it does not depend on the number of orbitals. The position matrices
+are still computed in every call.
 
 */
 ComplexMatrix orbital::localize(double prec, OrbitalVector &Phi, int spin) {
     OrbitalVector Phi_s = orbital::disjoin(Phi, spin);
     ComplexMatrix U = calc_localization_matrix(prec, Phi_s);
+    ComplexMatrix I = ComplexMatrix::Identity(U.rows(), U.cols());
     Timer rot_t;
-    mrcpp::mpifuncvec::rotate(Phi_s, U, prec);
+    if ((U - I).cwiseAbs().maxCoeff() < prec) {
+        U = I;
+    } else {
+        mrcpp::mpifuncvec::rotate(Phi_s, U, prec);
+    }
     Phi = orbital::adjoin(Phi, Phi_s);
     mrcpp::print::time(2, "Rotating orbitals", rot_t);
     return U;
@@ -752,30 +791,37 @@ ComplexMatrix orbital::localize(double prec, OrbitalVector &Phi, int spin) {
  *
  * The resulting transformation includes the orthonormalization of the orbitals.
  * Orbitals are rotated in place, and the transformation matrix is returned.
+ *
+ * The optimization starts from the current orbitals and its convergence threshold
+ * follows the precision, so that it is cheap in the early SCF iterations and
+ * returns immediately if the orbitals are already localized.
  */
 ComplexMatrix orbital::calc_localization_matrix(double prec, OrbitalVector &Phi) {
     ComplexMatrix U;
-    int n_it = 0;
     if (Phi.size() > 1) {
         Timer rmat_t;
         RRMaximizer rr(prec, Phi);
         mrcpp::print::time(2, "Computing position matrices", rmat_t);
 
         Timer rr_t;
-        n_it = rr.maximize();
+        bool jacobi = (Phi.size() > jacobi_localization_limit);
+        double grad_thrs = std::max(1.0e-12, prec * prec);
+        double angle_thrs = std::max(1.0e-10, 0.1 * prec);
+        int n_it = (jacobi) ? rr.maximizeJacobi(200, angle_thrs) : rr.maximize(grad_thrs);
         mrcpp::print::time(2, "Computing Foster-Boys matrix", rr_t);
 
         if (n_it > 0) {
-            println(2, " Foster-Boys localization converged in " << n_it << " iterations!");
-            U = rr.getTotalU().cast<ComplexDouble>();
+            println(2, " Foster-Boys localization converged in " << n_it << ((jacobi) ? " sweeps!" : " iterations!"));
+        } else if (n_it == 0) {
+            println(2, " Orbitals are already localized");
         } else {
             println(2, " Foster-Boys localization did not converge!");
-            U = rr.getTotalU().cast<ComplexDouble>();
         }
+        U = rr.getTotalU().cast<ComplexDouble>();
     } else {
         println(2, " Cannot localize less than two orbitals");
+        U = orbital::calc_lowdin_matrix(Phi);
     }
-    if (n_it == 0) U = orbital::calc_lowdin_matrix(Phi);
     return U;
 }
 
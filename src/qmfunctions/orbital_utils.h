@@ -49,6 +49,7 @@ OrbitalVector rotate(OrbitalVector &Phi, const ComplexMatrix &U, double prec = -
 
 OrbitalVector deep_copy(OrbitalVector &Phi);
 OrbitalVector param_copy(const OrbitalVector &Phi);
+OrbitalVector reproject(double prec, OrbitalVector &Phi);
 
 OrbitalVector adjoin(OrbitalVector &Phi_a, OrbitalVector &Phi_b);
 OrbitalVector disjoin(OrbitalVector &Phi, int spin);
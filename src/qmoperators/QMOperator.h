@@ -87,6 +87,9 @@ protected:
     virtual void setup(double prec) { setApplyPrec(prec); }
     virtual void clear() { clearApplyPrec(); }
 
+    // Whether apply() can be called concurrently on different orbitals
+    virtual bool isThreadSafe() const { return true; }
+
     virtual ComplexDouble evalf(const mrcpp::Coord<3> &r) const = 0;
 
     virtual Orbital apply(Orbital inp) = 0;
@@ -10,6 +10,11 @@
 #include "utils/PolyInterpolator.h"
 #include "qmoperators/QMOperator.h"
 #include "qmoperators/QMPotential.h"
+#include "utils/math_utils.h"
+
+#include <cmath>
+#include <limits>
+#include <map>
 
 /**
  * @brief Read ZORA potential from file. Check if file exists and abort if it does not.
@@ -47,36 +52,62 @@ void readZoraPotential(const std::string path, Eigen::VectorXd &rGrid, Eigen::Ve
 
 namespace mrchem {
 
+namespace {
+
+/**
+ * @brief Get the interpolated ZORA potential from file, reading each file only once.
+ * @param path Path to the file containing the ZORA potential
+ */
+std::shared_ptr<const interpolation_utils::PolyInterpolator> get_atomic_potential(const std::string &path) {
+    static std::map<std::string, std::shared_ptr<const interpolation_utils::PolyInterpolator>> potentials;
+    auto &pot = potentials[path];
+    if (pot == nullptr) {
+        Eigen::VectorXd rGrid, vZora, kappa;
+        readZoraPotential(path, rGrid, vZora, kappa);
+        pot = std::make_shared<const interpolation_utils::PolyInterpolator>(rGrid, vZora);
+    }
+    return pot;
+}
+
+} // namespace
+
     /**
      * Initialize the azora potential based on the molecule.
      * This method would typically setup the real and imaginary function trees
      * representing the potential.
      */
     void AZoraPotential::initAzoraPotential() {
-
-        int n = nucs.size();
-        Eigen::VectorXd rGrid, vZora, kappa;
         atomicPotentials.clear();
+        for (int i = 0; i < nucs.size(); i++) {
+            std::string element = nucs[i].getElement().getSymbol();
+            atomicPotentials.push_back(get_atomic_potential(this->azora_dir + '/' + element + ".txt"));
+        }
+    }
 
-        // std::vector<RadInterpolater> atomicPotentials;
-
-        std::string element;
-        std::string filename;
-        for (int i = 0; i < n; i++) {
-            element = nucs[i].getElement().getSymbol();
-            filename = this->azora_dir + '/' + element + ".txt";
-            readZoraPotential(filename, rGrid, vZora, kappa);
-            interpolation_utils::PolyInterpolator potential_interpolator(rGrid, vZora);
-
-            atomicPotentials.push_back(potential_interpolator);
+    void AZoraPotential::setupScreening(double proj_prec) {
+        // kappa - 1 ~ V / (2c^2) for small V
+        double thrs = 0.1 * proj_prec * 2.0 * c * c;
+        cutoffs.clear();
+        maxCutoff = 0.0;
+        for (auto &pot : atomicPotentials) {
+            double r_c = std::numeric_limits<double>::infinity();
+            if (std::abs(pot->evalfLeftNoRightConstant(1.0e6)) < thrs) {
+                double dr = 0.01;
+                r_c = 100.0;
+                while (r_c > dr and std::abs(pot->evalfLeftNoRightConstant(r_c)) < thrs) r_c -= dr;
+                r_c += dr;
+            }
+            cutoffs.push_back(r_c);
+            maxCutoff = std::max(maxCutoff, r_c);
         }
-        // project(this->prec);
+        if (std::isfinite(maxCutoff)) nucList = CellList(nucs, maxCutoff);
     }
 
     void AZoraPotential::project(double proj_prec){
         if (isProjected) free(mrchem::NUMBER::Total);
         mrcpp::ComplexFunction vtot;
         this->prec = proj_prec;
+        setupScreening(proj_prec);
         auto chi_analytic = [this](const mrcpp::Coord<3>& r) {
             return this->evalf_analytic(r);
         };
@@ -84,14 +115,26 @@ namespace mrchem {
         this->add(1.0, vtot);
         isProjected = true;
     }
+
+    bool AZoraPotential::hasProjection(double prec) const {
+        if (not isProjected or this->prec > prec) return false;
+        // a projection from another MRA (multilevel stages) cannot be reused
+        return this->hasReal() and this->real().getMRA() == *MRA;
+    }
     
-    double AZoraPotential::evalf_analytic(const mrcpp::Coord<3>& r){
+    double AZoraPotential::evalf_analytic(const mrcpp::Coord<3>& r) const {
         double V = 0.0;
-        // Loop over all atoms:
-        for (int i = 0; i < this->atomicPotentials.size(); i++) {
-            mrcpp::Coord<3> r_i = nucs[i].getCoord();
-            double rr = std::sqrt((r[0] - r_i[0]) * (r[0] - r_i[0]) + (r[1] - r_i[1]) * (r[1] - r_i[1]) + (r[2] - r_i[2]) * (r[2] - r_i[2]));
-            V += this->atomicPotentials[i].evalfLeftNoRightConstant(rr);
+        if (std::isfinite(this->maxCutoff)) {
+            // Only atoms within their cutoff radius contribute
+            this->nucList.forEachCandidate(r, this->maxCutoff, [this, &r, &V](int i) {
+                double rr = math_utils::calc_distance(r, nucs[i].getCoord());
+                if (rr < this->cutoffs[i]) V += this->atomicPotentials[i]->evalfLeftNoRightConstant(rr);
+            });
+        } else {
+            for (int i = 0; i < this->atomicPotentials.size(); i++) {
+                double rr = math_utils::calc_distance(r, nucs[i].getCoord());
+                V += this->atomicPotentials[i]->evalfLeftNoRightConstant(rr);
+            }
         }
         return 1 / (1 - V / (2.0 * c * c)) - 1;
     }
@@ -1,5 +1,7 @@
 #pragma once
+#include "chemistry/CellList.h"
 #include "chemistry/Nucleus.h"
+#include <memory>
 #include <vector>
 #include "utils/PolyInterpolator.h"
 #include "qmoperators/QMPotential.h"
@@ -61,15 +63,31 @@ public:
      */
     void project(double prec);
 
+    /**
+     * Check if the potential is projected with at least the given precision
+     * in the current MRA.
+     * @param prec Requested projection precision.
+     */
+    bool hasProjection(double prec) const;
+
 protected:
     Nuclei nucs; // The nuclei of the molecule
     double prec; // The precision parameter
     double c;    // The speed of light
     std::string azora_dir; // The directory containing the azora potential data
-    std::vector<interpolation_utils::PolyInterpolator> atomicPotentials;
+    std::vector<std::shared_ptr<const interpolation_utils::PolyInterpolator>> atomicPotentials; // Shared between atoms of the same element
+    std::vector<double> cutoffs; // Radius beyond which each atomic potential is neglected
+    double maxCutoff = 0.0;      // Largest of the cutoffs (infinite if no screening)
+    CellList nucList;            // Spatial index over the nuclei used for screening
     bool isProjected = false;
 
-    double evalf_analytic(const mrcpp::Coord<3>& r);
+    double evalf_analytic(const mrcpp::Coord<3>& r) const;
+
+    /**
+     * Compute the atomic cutoff radii such that the neglected tails of
+     * the atomic potentials do not affect kappa at the given precision.
+     */
+    void setupScreening(double prec);
 
     /**
      * Initialize the azora potential based on the molecule.
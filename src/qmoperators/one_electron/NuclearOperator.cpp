@@ -30,8 +30,11 @@
 
 #include "NuclearOperator.h"
 
+#include<algorithm>
+#include<cstdint>
 #include<fstream>
 #include<limits>
+#include<numeric>
 #include<nlohmann/json.hpp>
 
 #include "analyticfunctions/PointNucleusHFYGB.h"
@@ -51,6 +54,45 @@ using mrcpp::Timer;
 
 namespace mrchem {
 
+namespace {
+/** @brief Assign each nucleus to an MPI rank, keeping neighbouring nuclei together
+ *
+ * The nuclei are sorted along a Morton (Z-order) curve through their bounding
+ * box, and the sorted list is split into wrk_size contiguous blocks. Each rank
+ * thus projects a compact region of the molecule, which keeps its local tree
+ * small and reduces the overlap between the trees in the final reduction.
+ */
+std::vector<int> assign_spatial_ranks(const Nuclei &nucs, int n_ranks) {
+    int N = nucs.size();
+    std::vector<int> ranks(N, 0);
+    if (N == 0 or n_ranks <= 1) return ranks;
+
+    mrcpp::Coord<3> r_min = nucs[0].getCoord();
+    mrcpp::Coord<3> r_max = nucs[0].getCoord();
+    for (const auto &nuc : nucs) {
+        for (int d = 0; d < 3; d++) {
+            r_min[d] = std::min(r_min[d], nuc.getCoord()[d]);
+            r_max[d] = std::max(r_max[d], nuc.getCoord()[d]);
+        }
+    }
+
+    // Interleave 10 bits of each quantized coordinate
+    std::vector<uint32_t> codes(N, 0);
+    for (int k = 0; k < N; k++) {
+        for (int d = 0; d < 3; d++) {
+            double len = r_max[d] - r_min[d];
+            auto q = (len > 0.0) ? static_cast<uint32_t>(1023.0 * (nucs[k].getCoord()[d] - r_min[d]) / len) : 0u;
+            for (int b = 0; b < 10; b++) codes[k] |= ((q >> b) & 1u) << (3 * b + d);
+        }
+    }
+    std::vector<int> order(N);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&codes](int i, int j) { return codes[i] < codes[j]; });
+    for (int n = 0; n < N; n++) ranks[order[n]] = static_cast<int>((static_cast<long>(n) * n_ranks) / N);
+    return ranks;
+}
+} // namespace
+
 /*! @brief NuclearOperator represents the function: sum_i Z_i/|r - R_i|
  *  @param nucs: Collection of nuclei that defines the potential
  *  @param proj_prec: Precision for projection of analytic function
@@ -84,6 +126,7 @@ NuclearOperator::NuclearOperator(const Nuclei &nucs, double proj_prec, double sm
         MSG_ABORT("Invalid nuclear model : " << model);
     }
     setupLocalPotential(*f_loc, nucs, smooth_prec);
+    f_loc->setupScreening();
 
     // Scale precision by charge, since norm of potential is ~ to charge
     double Z_tot = 1.0 * chemistry::get_total_charge(nucs);
@@ -142,13 +185,14 @@ void NuclearOperator::setupLocalPotential(NuclearFunction &f_loc, const Nuclei &
     println(1, o_head.str());
     mrcpp::print::separator(1, '-');
 
+    auto proj_ranks = assign_spatial_ranks(nucs, mrcpp::mpi::wrk_size);
     for (int k = 0; k < nucs.size(); k++) {
         const Nucleus &nuc = nucs[k];
         double p1 = f_loc.calcParam1(smooth_prec, nuc);
         double p2 = f_loc.calcParam2(smooth_prec, nuc);
 
         // All projection must be done on grand master in order to be exact
-        int proj_rank = (mrcpp::mpi::numerically_exact) ? 0 : k % mrcpp::mpi::wrk_size;
+        int proj_rank = (mrcpp::mpi::numerically_exact) ? 0 : proj_ranks[k];
         if (mrcpp::mpi::wrk_rank == proj_rank) f_loc.push_back(nuc, p1, p2);
 
         std::stringstream o_row;
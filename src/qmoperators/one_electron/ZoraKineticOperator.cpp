@@ -0,0 +1,162 @@
+/*
+ * MRChem, a numerical real-space code for molecular electronic structure
+ * calculations within the self-consistent field (SCF) approximations of quantum
+ * chemistry (Hartree-Fock and Density Functional Theory).
+ * Copyright (C) 2023 Stig Rune Jensen, Luca Frediani, Peter Wind and contributors.
+ *
+ * This file is part of MRChem.
+ *
+ * MRChem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * MRChem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MRChem.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For information on the complete list of contributors to MRChem, see:
+ * <https://mrchem.readthedocs.io/>
+ */
+
+#include "ZoraKineticOperator.h"
+
+#include <MRCPP/Printer>
+#include <MRCPP/Timer>
+
+#include "MomentumOperator.h"
+#include "qmfunctions/orbital_utils.h"
+
+using mrcpp::Printer;
+using mrcpp::Timer;
+
+namespace mrchem {
+
+ZoraKineticOperator::ZoraKineticOperator(MomentumOperator &p, RankZeroOperator &chi)
+        : p(&p)
+        , chi(&chi) {}
+
+/** @brief Release the cached gradients */
+void ZoraKineticOperator::clear() {
+    this->Phi_cached.clear();
+    for (auto &dPhi_d : this->dPhi) dPhi_d.clear();
+    for (auto &chi_dPhi_d : this->chi_dPhi) chi_dPhi_d.clear();
+    this->T_mat = ComplexMatrix();
+}
+
+/** @brief Check whether the cached gradients belong to the given orbitals
+ *
+ * Orbitals are shallow copies, so the same orbitals share their function trees.
+ * The cache keeps a copy of the orbitals, so the trees cannot be reallocated at
+ * the same address while the cache is alive.
+ */
+bool ZoraKineticOperator::isCached(const OrbitalVector &Phi) const {
+    if (Phi.size() != this->Phi_cached.size() or this->dPhi[0].size() != Phi.size()) return false;
+    for (int i = 0; i < Phi.size(); i++) {
+        const Orbital &phi_i = Phi[i];
+        const Orbital &psi_i = this->Phi_cached[i];
+        if (phi_i.hasReal() != psi_i.hasReal() or phi_i.hasImag() != psi_i.hasImag()) return false;
+        if (phi_i.hasReal() and &phi_i.real() != &psi_i.real()) return false;
+        if (phi_i.hasImag() and &phi_i.imag() != &psi_i.imag()) return false;
+    }
+    return true;
+}
+
+void ZoraKineticOperator::computeGradients(OrbitalVector &Phi) {
+    if (isCached(Phi)) return;
+    clear();
+
+    Timer timer;
+    int nNodes = 0, sNodes = 0;
+    for (int d = 0; d < 3; d++) {
+        this->dPhi[d] = (*this->p)[d](Phi);
+        nNodes += orbital::get_n_nodes(this->dPhi[d]);
+        sNodes += orbital::get_size_nodes(this->dPhi[d]);
+    }
+    this->Phi_cached = Phi;
+    mrcpp::print::tree(2, "p[d]|i>", nNodes, sNodes, timer.elapsed());
+}
+
+void ZoraKineticOperator::computeChiGradients(OrbitalVector &Phi) {
+    computeGradients(Phi);
+    if (this->chi_dPhi[0].size() == Phi.size()) return;
+
+    Timer timer;
+    int nNodes = 0, sNodes = 0;
+    for (int d = 0; d < 3; d++) {
+        this->chi_dPhi[d] = (*this->chi)(this->dPhi[d]);
+        nNodes += orbital::get_n_nodes(this->chi_dPhi[d]);
+        sNodes += orbital::get_size_nodes(this->chi_dPhi[d]);
+    }
+    mrcpp::print::tree(2, "chi p[d]|i>", nNodes, sNodes, timer.elapsed());
+}
+
+/** @brief Kinetic matrix T_ij = 1/2 sum_d <p_d i|(1 + chi)|p_d j> */
+ComplexMatrix ZoraKineticOperator::calcMatrix(OrbitalVector &Phi) {
+    computeChiGradients(Phi);
+    if (this->T_mat.size() > 0) return this->T_mat;
+
+    Timer timer;
+    int N = Phi.size();
+    ComplexMatrix T = ComplexMatrix::Zero(N, N);
+    for (int d = 0; d < 3; d++) {
+        T += orbital::calc_overlap_matrix(this->dPhi[d], this->chi_dPhi[d]);
+        T += orbital::calc_overlap_matrix(this->dPhi[d]);
+    }
+    this->T_mat = 0.5 * T;
+    mrcpp::print::time(2, "<i|p(1+chi)p|j>", timer);
+    return this->T_mat;
+}
+
+/** @brief Kinetic energy sum_i occ_i T_ii
+ *
+ * Uses the diagonal of the kinetic matrix if it is already computed for these orbitals.
+ */
+double ZoraKineticOperator::calcTrace(OrbitalVector &Phi) {
+    computeGradients(Phi);
+    DoubleVector eta = orbital::get_occupations(Phi).cast<double>();
+    if (this->T_mat.size() > 0) return eta.dot(this->T_mat.real().diagonal());
+
+    Timer timer;
+    double E_kin = 0.0;
+    for (int d = 0; d < 3; d++) {
+        E_kin += this->chi->trace(this->dPhi[d]).real();
+        E_kin += eta.dot(orbital::get_squared_norms(this->dPhi[d]));
+    }
+    mrcpp::print::time(2, "Trace p(1+chi)p(rho)", timer);
+    return 0.5 * E_kin;
+}
+
+/** @brief Gradient term of the ZORA Helmholtz argument, 1/2 sum_d p_d chi p_d|phi_i>
+ *
+ * Releases the cached gradients component by component, since the orbitals are
+ * updated right after the Helmholtz argument is built.
+ */
+OrbitalVector ZoraKineticOperator::calcGradientTerm(OrbitalVector &Phi) {
+    computeChiGradients(Phi);
+
+    OrbitalVector out;
+    for (int d = 0; d < 3; d++) {
+        OrbitalVector p_chi_dPhi = (*this->p)[d](this->chi_dPhi[d]);
+        this->chi_dPhi[d].clear();
+        this->dPhi[d].clear();
+        if (d == 0) {
+            out = p_chi_dPhi;
+        } else {
+            for (int i = 0; i < out.size(); i++) {
+                if (mrcpp::mpi::my_orb(out[i])) out[i].add(1.0, p_chi_dPhi[i]);
+            }
+        }
+    }
+    for (int i = 0; i < out.size(); i++) {
+        if (mrcpp::mpi::my_orb(out[i])) out[i].rescale(0.5);
+    }
+    clear();
+    return out;
+}
+
+} // namespace mrchem
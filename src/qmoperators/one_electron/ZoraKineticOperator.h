@@ -0,0 +1,77 @@
+/*
+ * MRChem, a numerical real-space code for molecular electronic structure
+ * calculations within the self-consistent field (SCF) approximations of quantum
+ * chemistry (Hartree-Fock and Density Functional Theory).
+ * Copyright (C) 2023 Stig Rune Jensen, Luca Frediani, Peter Wind and contributors.
+ *
+ * This file is part of MRChem.
+ *
+ * MRChem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * MRChem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MRChem.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For information on the complete list of contributors to MRChem, see:
+ * <https://mrchem.readthedocs.io/>
+ */
+
+#pragma once
+
+#include <array>
+
+#include "qmfunctions/Orbital.h"
+#include "tensor/RankZeroOperator.h"
+
+namespace mrchem {
+
+class MomentumOperator;
+
+/**
+ * @class ZoraKineticOperator
+ * @brief ZORA kinetic energy T = 1/2 p (1 + chi) p, built from one set of orbital gradients
+ *
+ * The kinetic matrix, the kinetic trace and the gradient term of the ZORA Helmholtz
+ * argument all need the momentum components p_d|phi_i>, and the matrix and the
+ * gradient term both need chi p_d|phi_i>. This class computes them once for a given
+ * orbital vector and keeps them until clear() is called or a different orbital
+ * vector is passed, so that the three quantities can be derived from the same
+ * gradients. The cache holds up to six extra orbitals per orbital. It is released
+ * by calcGradientTerm(), which is the last use before the orbitals are updated.
+ */
+class ZoraKineticOperator final {
+public:
+    /**
+     * @param p Momentum operator, must be set up
+     * @param chi The chi = kappa - 1 operator, must be set up
+     */
+    ZoraKineticOperator(MomentumOperator &p, RankZeroOperator &chi);
+
+    ComplexMatrix calcMatrix(OrbitalVector &Phi);
+    double calcTrace(OrbitalVector &Phi);
+    OrbitalVector calcGradientTerm(OrbitalVector &Phi);
+
+    void clear();
+
+private:
+    MomentumOperator *p;
+    RankZeroOperator *chi;
+
+    OrbitalVector Phi_cached;                ///< Shallow copy of the orbitals the gradients belong to
+    std::array<OrbitalVector, 3> dPhi;       ///< p_d|phi_i> for d = x, y, z
+    std::array<OrbitalVector, 3> chi_dPhi;   ///< chi p_d|phi_i> for d = x, y, z, empty if not computed
+    ComplexMatrix T_mat;                     ///< Kinetic matrix of Phi_cached, empty if not computed
+
+    bool isCached(const OrbitalVector &Phi) const;
+    void computeGradients(OrbitalVector &Phi);
+    void computeChiGradients(OrbitalVector &Phi);
+};
+
+} // namespace mrchem
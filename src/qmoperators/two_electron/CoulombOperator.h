@@ -72,6 +72,9 @@ public:
     auto &getPoisson() { return this->potential->getPoisson(); }
     auto &getDensity() { return this->potential->getDensity(); }
 
+    void includeNuclear(double prec, const Nuclei &nucs, mrcpp::ComplexFunction &V_nuc, double alpha) { this->potential->setupNuclearCorrection(prec, nucs, V_nuc, alpha); }
+    bool includesNuclear() const { return this->potential->includesNuclear(); }
+
 private:
     std::shared_ptr<CoulombPotential> potential{nullptr};
 };
@@ -27,6 +27,7 @@
 
 #include "qmoperators/QMPotential.h"
 
+#include "chemistry/chemistry_fwd.h"
 #include "qmfunctions/Density.h"
 
 /** @class CoulombPotential
@@ -45,6 +46,9 @@
  * on-the-fly in setup() ONLY if it is not already available. After setup() the
  * operator will be fixed until clear(), which deletes both the density and the
  * potential.
+ *
+ * Optionally, the nuclear attraction can be included to give the total electrostatic
+ * potential from a single Poisson solve, see setupNuclearCorrection().
  */
 
 namespace mrchem {
@@ -57,7 +61,9 @@ public:
     friend class CoulombOperator;
 
 protected:
-    Density density; ///< Ground-state electron density
+    Density density;                       ///< Ground-state electron density
+    Density nuc_density;                   ///< Smeared nuclear charge density (combined electrostatics)
+    mrcpp::ComplexFunction nuc_correction; ///< Short-range nuclear correction (combined electrostatics)
 
     std::shared_ptr<OrbitalVector> orbitals;         ///< Unperturbed orbitals defining the ground-state electron density
     std::shared_ptr<mrcpp::PoissonOperator> poisson; ///< Operator used to compute the potential
@@ -66,6 +72,8 @@ protected:
     auto &getDensity() { return this->density; }
 
     bool hasDensity() const { return (this->density.squaredNorm() < 0.0) ? false : true; }
+    bool includesNuclear() const { return this->nuc_correction.hasReal(); }
+    void setupNuclearCorrection(double prec, const Nuclei &nucs, mrcpp::ComplexFunction &V_nuc, double alpha);
 
     void setup(double prec) override;
     void clear() override;
@@ -74,6 +82,7 @@ protected:
     virtual void setupLocalDensity(double prec) {}
 
     void setupGlobalPotential(double prec);
+    void applyPoisson(double prec, mrcpp::ComplexFunction &V, bool incl_nuc);
     mrcpp::ComplexFunction setupLocalPotential(double prec);
     void allreducePotential(double prec, mrcpp::ComplexFunction &V_loc);
 };
@@ -71,6 +71,7 @@ protected:
     void rotate(const ComplexMatrix &U);
     void setup(double prec) override;
     void clear() override;
+    bool isThreadSafe() const override { return false; } // may fetch orbitals from the bank
 
     virtual void setupBank() = 0;
     virtual void clearBank() {}
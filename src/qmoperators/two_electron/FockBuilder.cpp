@@ -43,6 +43,7 @@
 #include "qmoperators/one_electron/KineticOperator.h"
 #include "qmoperators/one_electron/NablaOperator.h"
 #include "qmoperators/one_electron/NuclearOperator.h"
+#include "qmoperators/one_electron/ZoraKineticOperator.h"
 #include "qmoperators/one_electron/ZoraOperator.h"
 #include "qmoperators/qmoperator_utils.h"
 #include "utils/math_utils.h"
@@ -62,8 +63,11 @@ namespace mrchem {
 void FockBuilder::build(double exx) {
     this->exact_exchange = exx;
 
+    // The Coulomb operator may already contain the nuclear attraction
+    bool coul_has_nuc = (this->coul != nullptr) and this->coul->includesNuclear();
+
     this->V = RankZeroOperator();
-    if (this->nuc != nullptr) this->V += (*this->nuc);
+    if (this->nuc != nullptr and not coul_has_nuc) this->V += (*this->nuc);
     if (this->coul != nullptr) this->V += (*this->coul);
     if (this->ex != nullptr) this->V -= this->exact_exchange * (*this->ex);
     if (this->xc != nullptr) this->V += (*this->xc);
@@ -91,6 +95,10 @@ void FockBuilder::setup(double prec) {
     if (this->mom != nullptr) this->momentum().setup(prec);
     this->potential().setup(prec);
     this->perturbation().setup(prec);
+    // With combined electrostatics V_nuc is not part of V, but it is still
+    // needed separately for the nuclear energy in trace()
+    bool coul_has_nuc = (this->coul != nullptr) and this->coul->includesNuclear();
+    if (this->nuc != nullptr and coul_has_nuc) this->nuc->setup(prec);
 
     if (isZora()) {
         Timer t_zora;
@@ -100,13 +108,20 @@ void FockBuilder::setup(double prec) {
         mrcpp::print::value(3, "Light speed", c, "(au)", 5);
         mrcpp::print::separator(3, '-');
         auto vz = collectZoraBasePotential();
-        // chi = kappa - 1. See ZoraOperator.h for more information.
-        this->chi = std::make_shared<ZoraOperator>(*vz, c, prec, false);
-        this->chi_inv = std::make_shared<ZoraOperator>(*vz, c, prec, true);
-        this->zora_base = RankZeroOperator(vz);
+        if (needZoraRebuild(*vz, prec)) {
+            // chi = kappa - 1. See ZoraOperator.h for more information.
+            this->chi = std::make_shared<ZoraOperator>(*vz, c, prec, false);
+            this->chi_inv = std::make_shared<ZoraOperator>(*vz, c, prec, true);
+            this->zora_base = RankZeroOperator(vz);
+            this->zora_prec = prec;
+        } else {
+            // keep the base potential that chi was built from, for consistency
+            println(2, " Reusing ZORA operators from previous iteration");
+        }
         this->chi->setup(prec);
         this->chi_inv->setup(prec);
         this->zora_base.setup(prec);
+        this->zora_kin = std::make_shared<ZoraKineticOperator>(momentum(), *this->chi);
         mrcpp::print::footer(3, t_zora, 2);
     }
     if (isAZora()) {
@@ -118,17 +133,21 @@ void FockBuilder::setup(double prec) {
         mrcpp::print::separator(3, '-');
         int adap = 0;
 
-        chiPot->project(prec);
-        chiInvPot = std::make_shared<QMPotential>(adap);
+        // kappa depends only on the nuclei, keep it between SCF iterations
+        if (not chiPot->hasProjection(prec)) {
+            chiPot->project(prec);
+            chiInvPot = std::make_shared<QMPotential>(adap);
 
-        mrcpp::cplxfunc::deep_copy(*chiInvPot, *chiPot);
+            mrcpp::cplxfunc::deep_copy(*chiInvPot, *chiPot);
 
-        chiInvPot->real().map([](double val) { return 1.0 / (val + 1) - 1; });
+            chiInvPot->real().map([](double val) { return 1.0 / (val + 1) - 1; });
+        }
 
         this->chi = std::make_shared<ZoraOperator>(chiPot, "kappa");
         this->chi_inv = std::make_shared<ZoraOperator>(chiInvPot, "kappa_inv");
         this->chi->setup(prec);
         this->chi_inv->setup(prec);
+        this->zora_kin = std::make_shared<ZoraKineticOperator>(momentum(), *this->chi);
 
         mrcpp::print::footer(3, t_zora, 2);
     }
@@ -147,6 +166,8 @@ void FockBuilder::clear() {
     if (this->mom != nullptr) this->momentum().clear();
     this->potential().clear();
     this->perturbation().clear();
+    bool coul_has_nuc = (this->coul != nullptr) and this->coul->includesNuclear();
+    if (this->nuc != nullptr and coul_has_nuc) this->nuc->clear();
     if (isZora()) {
         this->chi->clear();
         this->chi_inv->clear();
@@ -155,9 +176,8 @@ void FockBuilder::clear() {
     if (isAZora()) {
         chi->clear();
         chi_inv->clear();
-        chiPot->free(mrchem::NUMBER::Total);
-        chiInvPot->free(mrchem::NUMBER::Total);
     }
+    this->zora_kin.reset();
 }
 
 /** @brief rotate orbitals of two-electron operators
@@ -170,6 +190,7 @@ void FockBuilder::clear() {
  */
 void FockBuilder::rotate(const ComplexMatrix &U) {
     if (this->ex != nullptr) this->ex->rotate(U);
+    if (this->zora_kin != nullptr) this->zora_kin->clear();
 }
 
 /** @brief compute the SCF energy
@@ -214,7 +235,8 @@ SCFEnergy FockBuilder::trace(OrbitalVector &Phi, const Nuclei &nucs) {
 
     // Kinetic part
     if (isZora() || isAZora()) {
-        E_kin = qmoperator::calc_kinetic_trace(momentum(), *this->chi, Phi).real() + qmoperator::calc_kinetic_trace(momentum(), Phi);
+        if (this->zora_kin == nullptr) MSG_ABORT("ZORA operators not set up");
+        E_kin = this->zora_kin->calcTrace(Phi);
     } else {
         E_kin = qmoperator::calc_kinetic_trace(momentum(), Phi);
     }
@@ -222,7 +244,14 @@ SCFEnergy FockBuilder::trace(OrbitalVector &Phi, const Nuclei &nucs) {
     // Electronic part
     if (this->nuc != nullptr) { E_en = this->nuc->trace(Phi).real(); }
 
-    if (this->coul != nullptr) E_ee = 0.5 * this->coul->trace(Phi).real();
+    if (this->coul != nullptr) {
+        double E_coul = this->coul->trace(Phi).real();
+        if (this->coul->includesNuclear()) {
+            if (this->nuc == nullptr) MSG_ERROR("Nuclear operator required to split the electrostatic energy");
+            E_coul -= E_en;
+        }
+        E_ee = 0.5 * E_coul;
+    }
     if (this->ex != nullptr) E_x = -this->exact_exchange * this->ex->trace(Phi).real();
     if (this->xc != nullptr) E_xc = this->xc->getEnergy();
     if (this->ext != nullptr) E_eext = this->ext->trace(Phi).real();
@@ -239,7 +268,11 @@ ComplexMatrix FockBuilder::operator()(OrbitalVector &bra, OrbitalVector &ket) {
 
     ComplexMatrix T_mat = ComplexMatrix::Zero(bra.size(), ket.size());
     if (isZora() || isAZora()) {
-        T_mat = qmoperator::calc_kinetic_matrix(momentum(), *this->chi, bra, ket) + qmoperator::calc_kinetic_matrix(momentum(), bra, ket);
+        if (&bra == &ket and this->zora_kin != nullptr) {
+            T_mat = this->zora_kin->calcMatrix(ket);
+        } else {
+            T_mat = qmoperator::calc_kinetic_matrix(momentum(), *this->chi, bra, ket) + qmoperator::calc_kinetic_matrix(momentum(), bra, ket);
+        }
     } else {
         T_mat = qmoperator::calc_kinetic_matrix(momentum(), bra, ket);
     }
@@ -252,7 +285,18 @@ ComplexMatrix FockBuilder::operator()(OrbitalVector &bra, OrbitalVector &ket) {
     return T_mat + V_mat;
 }
 
-OrbitalVector FockBuilder::buildHelmholtzArgument(double prec, OrbitalVector Phi, ComplexMatrix F_mat, ComplexMatrix L_mat) {
+/** @brief Build the argument of the Helmholtz operators
+ *
+ * @param prec: precision of the orbital rotation and operator application
+ * @param Phi: orbitals
+ * @param F_mat: Fock matrix
+ * @param L_mat: diagonal matrix of Helmholtz parameters
+ * @param active: indices of the orbitals to compute the argument for (empty means all)
+ *
+ * All orbitals enter the rotation (L - F)|Phi>, but the potential is only applied to
+ * the active orbitals, and only their arguments are returned, in the order of active.
+ */
+OrbitalVector FockBuilder::buildHelmholtzArgument(double prec, OrbitalVector Phi, ComplexMatrix F_mat, ComplexMatrix L_mat, const std::vector<int> &active) {
     Timer t_tot;
     auto plevel = Printer::getPrintLevel();
     mrcpp::print::header(2, "Computing Helmholtz argument");
@@ -261,9 +305,23 @@ OrbitalVector FockBuilder::buildHelmholtzArgument(double prec, OrbitalVector Phi
     OrbitalVector Psi = orbital::rotate(Phi, L_mat - F_mat, prec);
     mrcpp::print::time(2, "Rotating orbitals", t_rot);
 
+    DoubleVector eps = F_mat.real().diagonal();
+    if (not active.empty()) {
+        OrbitalVector Phi_act, Psi_act;
+        DoubleVector eps_act(active.size());
+        for (int k = 0; k < active.size(); k++) {
+            Phi_act.push_back(Phi[active[k]]);
+            Psi_act.push_back(Psi[active[k]]);
+            eps_act(k) = eps(active[k]);
+        }
+        Phi = Phi_act;
+        Psi = Psi_act;
+        eps = eps_act;
+    }
+
     OrbitalVector out;
     if (isZora() || isAZora()) {
-        out = buildHelmholtzArgumentZORA(Phi, Psi, F_mat.real().diagonal(), prec);
+        out = buildHelmholtzArgumentZORA(Phi, Psi, eps, prec);
     } else {
         out = buildHelmholtzArgumentNREL(Phi, Psi);
     }
@@ -281,11 +339,9 @@ OrbitalVector FockBuilder::buildHelmholtzArgumentZORA(OrbitalVector &Phi, Orbita
     // Get necessary operators
     double c = getLightSpeed();
     double two_cc = 2.0 * c * c;
-    MomentumOperator &p = momentum();
     RankZeroOperator &V = potential();
     RankZeroOperator &chi = *this->chi;
     RankZeroOperator &chi_m1 = *this->chi_inv;
-    RankZeroOperator operOne = 0.5 * tensor::dot(p(chi), p);
 
     std::shared_ptr<RankZeroOperator> operThreePtr = nullptr;
 
@@ -307,12 +363,12 @@ OrbitalVector FockBuilder::buildHelmholtzArgumentZORA(OrbitalVector &Phi, Orbita
 
     RankZeroOperator operThree = *operThreePtr;
 
-    operOne.setup(prec);
     operThree.setup(prec);
 
-    // Compute OrbitalVectors
+    // Compute OrbitalVectors, reusing p|phi> from the Fock matrix if available
+    if (this->zora_kin == nullptr) MSG_ABORT("ZORA operators not set up");
     Timer t_1;
-    OrbitalVector termOne = operOne(Phi);
+    OrbitalVector termOne = this->zora_kin->calcGradientTerm(Phi);
     mrcpp::print::time(2, "Computing gradient term", t_1);
 
     Timer t_2;
@@ -347,7 +403,6 @@ OrbitalVector FockBuilder::buildHelmholtzArgumentZORA(OrbitalVector &Phi, Orbita
     mrcpp::print::time(2, "Adding contributions", t_add);
 
     operThree.clear();
-    operOne.clear();
 
     Timer t_kappa;
     mrchem::OrbitalVector out = chi_m1(arg);
@@ -388,14 +443,49 @@ void FockBuilder::setZoraType(bool has_nuc, bool has_coul, bool has_xc, bool is_
     this->zora_is_azora = is_azora;
 }
 
+/** @brief check whether chi and chi_inv must be rebuilt from a new base potential
+ *
+ * @param vz: the current ZORA base potential
+ * @param prec: current precision
+ *
+ * The operators are always rebuilt the first time, if the requested precision
+ * is tighter than the one they were built with, and if they belong to another MRA. Otherwise they are kept after
+ * zora_freeze_iter SCF iterations, or if the relative change in the base potential since
+ * they were built is below zora_rebuild_thrs * prec.
+ */
+bool FockBuilder::needZoraRebuild(QMPotential &vz, double prec) {
+    if (this->chi == nullptr or this->chi_inv == nullptr) return true;
+    if (this->zora_prec < 0.0 or prec < this->zora_prec) return true;
+
+    // operators from another MRA (multilevel stages) cannot be reused
+    auto &vz_old = static_cast<QMPotential &>(this->zora_base.getRaw(0, 0));
+    if (not vz_old.hasReal() or not (vz_old.real().getMRA() == *MRA)) return true;
+
+    if (this->zora_freeze_iter >= 0 and this->zora_iter >= this->zora_freeze_iter) return false;
+    if (this->zora_rebuild_thrs < 0.0) return true;
+
+    double norm_old = vz_old.norm();
+    if (norm_old <= 0.0) return true;
+
+    QMPotential dvz(1, false);
+    mrcpp::cplxfunc::add(dvz, 1.0, vz, -1.0, vz_old, -1.0);
+    double rel_diff = dvz.norm() / norm_old;
+    mrcpp::print::value(2, "ZORA potential change", rel_diff, "(rel)", 5);
+    return (rel_diff > this->zora_rebuild_thrs * prec);
+}
+
 std::shared_ptr<QMPotential> FockBuilder::collectZoraBasePotential() {
     Timer timer;
     auto vz = std::make_shared<QMPotential>(1, false);
-    if (zora_has_nuc) {
+
+    // With combined electrostatics the Coulomb potential already holds V_nuc
+    double nuc_coef = (zora_has_nuc) ? 1.0 : 0.0;
+    if (zora_has_coul and getCoulombOperator() != nullptr and getCoulombOperator()->includesNuclear()) nuc_coef -= 1.0;
+    if (zora_has_nuc or nuc_coef != 0.0) {
         if (getNuclearOperator() != nullptr) {
             auto &vnuc = static_cast<QMPotential &>(getNuclearOperator()->getRaw(0, 0));
             if (not vnuc.hasReal()) MSG_ERROR("ZORA: Adding empty nuclear potential");
-            vz->add(1.0, vnuc);
+            if (nuc_coef != 0.0) vz->add(nuc_coef, vnuc);
         } else {
             MSG_ERROR("ZORA: Nuclear requested but not available");
         }
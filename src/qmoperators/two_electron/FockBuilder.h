@@ -84,13 +84,18 @@ public:
     bool isAZora() const { return zora_is_azora; }
     bool isZora() const { return (zora_has_nuc || zora_has_coul || zora_has_xc); }
     void setZoraType(bool has_nuc, bool has_coul, bool has_xc, bool is_azora);
+    void setZoraReuse(double thrs, int freeze_iter) {
+        this->zora_rebuild_thrs = thrs;
+        this->zora_freeze_iter = freeze_iter;
+    }
+    void setZoraIteration(int iter) { this->zora_iter = iter; }
     void setAZORADirectory(const std::string &dir) {azora_dir = dir;}
     void setNucs(const Nuclei &nucs) { this->nucs = nucs;}
 
     SCFEnergy trace(OrbitalVector &Phi, const Nuclei &nucs);
     ComplexMatrix operator()(OrbitalVector &bra, OrbitalVector &ket);
 
-    OrbitalVector buildHelmholtzArgument(double prec, OrbitalVector Phi, ComplexMatrix F_mat, ComplexMatrix L_mat);
+    OrbitalVector buildHelmholtzArgument(double prec, OrbitalVector Phi, ComplexMatrix F_mat, ComplexMatrix L_mat, const std::vector<int> &active = {});
 
 private:
     bool zora_has_nuc{false};
@@ -101,6 +106,11 @@ private:
     std::string azora_dir_src = "";
     std::string azora_dir_install = "";
 
+    double zora_rebuild_thrs{-1.0}; ///< Rebuild chi if |dV_zora|/|V_zora| exceeds thrs * prec, negative: always
+    int zora_freeze_iter{-1};        ///< Stop rebuilding chi after this many SCF iterations, negative: never
+    int zora_iter{-1};               ///< Current SCF iteration, negative: outside the SCF loop
+    double zora_prec{-1.0};          ///< Precision of the current chi and chi_inv
+
     double light_speed{-1.0};
     double exact_exchange{1.0};
     RankZeroOperator zora_base;
@@ -120,8 +130,10 @@ private:
     std::shared_ptr<ElectricFieldOperator> ext{nullptr}; // Total external potential
     std::shared_ptr<ZoraOperator> chi{nullptr};
     std::shared_ptr<ZoraOperator> chi_inv{nullptr};
+    std::shared_ptr<ZoraKineticOperator> zora_kin{nullptr}; ///< Caches p|phi> between setup() and clear()
 
     std::shared_ptr<QMPotential> collectZoraBasePotential();
+    bool needZoraRebuild(QMPotential &vz, double prec);
     OrbitalVector buildHelmholtzArgumentZORA(OrbitalVector &Phi, OrbitalVector &Psi, DoubleVector eps, double prec);
     OrbitalVector buildHelmholtzArgumentNREL(OrbitalVector &Phi, OrbitalVector &Psi);
     std::shared_ptr<AZoraPotential> chiPot{nullptr}; // Potential for AZORA chi operator
@@ -106,6 +106,7 @@ void XCPotential::clear() {
     this->energy = 0.0;
     for (auto &rho : this->densities) rho.free(NUMBER::Total);
     mrcpp::clear(this->potentials, true);
+    this->v_tot.reset();
     clearApplyPrec();
 }
 
@@ -131,6 +132,10 @@ Density &XCPotential::getDensity(DensityType spin, int pert_idx) {
 /** @brief Return FunctionTree for the XC spin potential
  *
  * @param[in] type Which spin potential to return (alpha, beta or total)
+ *
+ * For spin functionals the total potential (alpha + beta) is computed
+ * on first request and kept until clear(), so that repeated applications
+ * to paired orbitals do not redo the addition.
  */
 FunctionTree<3> &XCPotential::getPotential(int spin) {
     int nPots = this->potentials.size();
@@ -145,8 +150,12 @@ FunctionTree<3> &XCPotential::getPotential(int spin) {
     } else if (not spinFunctional) {
         pot_idx = 0;
     } else if (spinFunctional and spin == SPIN::Paired) {
-        this->v_tot = std::make_shared<FunctionTree<3>>(*MRA);
-        mrcpp::add(prec(), *this->v_tot, this->potentials);
+#pragma omp critical(xc_v_tot)
+        if (this->v_tot == nullptr) {
+            auto v_sum = std::make_shared<FunctionTree<3>>(*MRA);
+            mrcpp::add(prec(), *v_sum, this->potentials);
+            this->v_tot = v_sum;
+        }
         return *this->v_tot;
     } else {
         NOT_IMPLEMENTED_ABORT;
@@ -158,30 +167,55 @@ FunctionTree<3> &XCPotential::getPotential(int spin) {
  *
  * @param[in] phi Orbital to which the potential is applied
  *
- * The operator is applied by choosing the correct potential function
- * which is then assigned to the real function part of the operator
- * base-class before the base class function is called.
+ * The operator is applied by choosing the correct potential function, which is
+ * multiplied directly with the orbital. The base class function is left untouched,
+ * so that several orbitals can be applied concurrently by different threads.
  */
 Orbital XCPotential::apply(Orbital phi) {
-    QMPotential &V = *this;
-    if (V.hasImag()) MSG_ERROR("Imaginary part of XC potential non-zero");
+    if (this->apply_prec < 0.0) MSG_ERROR("Uninitialized operator");
+    if (this->hasImag()) MSG_ERROR("Imaginary part of XC potential non-zero");
 
     FunctionTree<3> &pot = getPotential(phi.spin());
-    V.setReal(&pot);
-    Orbital Vphi = QMPotential::apply(phi);
-    V.setReal(nullptr);
-    return Vphi;
+    return applyPotential(pot, phi);
 }
 
+/** @brief XCPotentialD1 application of the adjoint
+ *
+ * The XC potential is real, so this is the same as apply().
+ */
 Orbital XCPotential::dagger(Orbital phi) {
-    QMPotential &V = *this;
-    if (V.hasImag()) MSG_ERROR("Imaginary part of XC potential non-zero");
+    return apply(phi);
+}
 
-    FunctionTree<3> &pot = getPotential(phi.spin());
-    V.setReal(&pot);
-    Orbital Vphi = QMPotential::dagger(phi);
-    V.setReal(nullptr);
-    return Vphi;
+/** @brief multiply an orbital by a real potential function
+ *
+ * @param[in] pot Real potential function
+ * @param[in] phi Orbital to which the potential is applied
+ *
+ * Same as QMPotential::calcRealPart/calcImagPart for a purely real potential,
+ * but with the potential passed as argument instead of taken from the base class.
+ */
+Orbital XCPotential::applyPotential(FunctionTree<3> &pot, Orbital &phi) {
+    int adap = this->adap_build;
+    double prec = this->apply_prec;
+
+    Orbital out = phi.paramCopy();
+    if (phi.hasReal()) {
+        mrcpp::ComplexFunction tmp(false);
+        tmp.alloc(NUMBER::Real);
+        mrcpp::copy_grid(tmp.real(), phi.real());
+        mrcpp::multiply(prec, tmp.real(), 1.0, pot, phi.real(), adap);
+        out.add(1.0, tmp);
+    }
+    if (phi.hasImag()) {
+        double coef = (phi.conjugate()) ? -1.0 : 1.0;
+        mrcpp::ComplexFunction tmp(false);
+        tmp.alloc(NUMBER::Imag);
+        mrcpp::copy_grid(tmp.imag(), phi.imag());
+        mrcpp::multiply(prec, tmp.imag(), coef, pot, phi.imag(), adap);
+        out.add(1.0, tmp);
+    }
+    return out;
 }
 
 QMOperatorVector XCPotential::apply(QMOperator_p &O) {
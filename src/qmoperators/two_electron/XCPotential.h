@@ -76,7 +76,7 @@ protected:
     double energy;                           ///< XC energy
     std::vector<Density> densities;          ///< XC densities (total or alpha/beta)
     mrcpp::FunctionTreeVector<3> potentials; ///< XC Potential functions collected in a vector
-    std::shared_ptr<mrcpp::FunctionTree<3>> v_tot{nullptr};            ///< Total XC potential
+    std::shared_ptr<mrcpp::FunctionTree<3>> v_tot{nullptr}; ///< Total XC potential (spin functionals), cached until clear()
     std::shared_ptr<OrbitalVector> orbitals; ///< External set of orbitals used to build the density
     std::unique_ptr<mrdft::MRDFT> mrdft;     ///< External XC functional to be used
 
@@ -92,6 +92,8 @@ protected:
     Orbital apply(Orbital phi) override;
     Orbital dagger(Orbital phi) override;
     QMOperatorVector apply(std::shared_ptr<QMOperator> &O) override;
+
+    Orbital applyPotential(mrcpp::FunctionTree<3> &pot, Orbital &phi);
 };
 
 } // namespace mrchem
\ No newline at end of file
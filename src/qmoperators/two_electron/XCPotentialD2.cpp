@@ -94,27 +94,30 @@ mrcpp::FunctionTreeVector<3> XCPotentialD2::setupDensities(double prec, mrcpp::F
             dens_vec.push_back(std::make_tuple(1.0, &rho.real()));
         }
     } else {
-        { // Unperturbed alpha density
+        { // Unperturbed alpha and beta densities in one pass
             Timer timer;
-            Density &rho = getDensity(DensityType::Alpha, 0);
-            if (not rho.hasReal()) {
-                rho.alloc(NUMBER::Real);
-                mrcpp::copy_grid(rho.real(), grid);
-                density::compute(prec, rho, *orbitals, DensityType::Alpha);
+            Density &rho_a = getDensity(DensityType::Alpha, 0);
+            Density &rho_b = getDensity(DensityType::Beta, 0);
+            std::vector<Density *> rho_vec;
+            std::vector<DensityType> spin_vec;
+            if (not rho_a.hasReal()) {
+                rho_a.alloc(NUMBER::Real);
+                mrcpp::copy_grid(rho_a.real(), grid);
+                rho_vec.push_back(&rho_a);
+                spin_vec.push_back(DensityType::Alpha);
             }
-            print_utils::qmfunction(3, "Compute rho_0 (alpha)", rho, timer);
-            dens_vec.push_back(std::make_tuple(1.0, &rho.real()));
-        }
-        { // Unperturbed beta density
-            Timer timer;
-            Density &rho = getDensity(DensityType::Beta, 0);
-            if (not rho.hasReal()) {
-                rho.alloc(NUMBER::Real);
-                mrcpp::copy_grid(rho.real(), grid);
-                density::compute(prec, rho, *orbitals, DensityType::Beta);
+            if (not rho_b.hasReal()) {
+                rho_b.alloc(NUMBER::Real);
+                mrcpp::copy_grid(rho_b.real(), grid);
+                rho_vec.push_back(&rho_b);
+                spin_vec.push_back(DensityType::Beta);
             }
-            print_utils::qmfunction(3, "Compute rho_0 (beta)", rho, timer);
-            dens_vec.push_back(std::make_tuple(1.0, &rho.real()));
+            if (rho_vec.size() > 0) density::compute(prec, rho_vec, *orbitals, spin_vec);
+            auto nodes = rho_a.getNNodes(NUMBER::Total) + rho_b.getNNodes(NUMBER::Total);
+            auto memory = rho_a.getSizeNodes(NUMBER::Total) + rho_b.getSizeNodes(NUMBER::Total);
+            mrcpp::print::tree(3, "Compute rho_0 (alpha+beta)", nodes, memory, timer.elapsed());
+            dens_vec.push_back(std::make_tuple(1.0, &rho_a.real()));
+            dens_vec.push_back(std::make_tuple(1.0, &rho_b.real()));
         }
         { // Perturbed alpha density
             Timer timer;
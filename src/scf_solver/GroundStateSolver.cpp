@@ -23,6 +23,8 @@
  * <https://mrchem.readthedocs.io/>
  */
 
+#include <numeric>
+
 #include <MRCPP/Printer>
 #include <MRCPP/Timer>
 
@@ -180,6 +182,13 @@ void GroundStateSolver::printParameters(const std::string &calculation) const {
         o_thrs_o << std::setprecision(5) << std::scientific << this->orbThrs;
     }
 
+    std::stringstream o_lock;
+    if (this->lockThrs < 0.0) {
+        o_lock << "Off";
+    } else {
+        o_lock << std::setprecision(1) << std::scientific << this->lockThrs << " x prec, " << this->lockIter << " cycles";
+    }
+
     std::stringstream o_helm;
     if (this->helmPrec < 0.0) {
         o_helm << "Dynamic";
@@ -207,6 +216,7 @@ void GroundStateSolver::printParameters(const std::string &calculation) const {
     print_utils::text(0, "Helmholtz precision", o_helm.str());
     print_utils::text(0, "Energy threshold   ", o_thrs_p.str());
     print_utils::text(0, "Orbital threshold  ", o_thrs_o.str());
+    print_utils::text(0, "Orbital locking    ", o_lock.str());
     mrcpp::print::separator(0, '~', 2);
 }
 
@@ -240,6 +250,11 @@ void GroundStateSolver::reset() {
  * 10) Setup Fock operator
  * 11) Compute Fock matrix
  *
+ * With orbital locking, orbitals whose updates stay below lockThrs times the current
+ * precision for lockIter cycles are left out of steps 3) and 6). They still take part
+ * in the orthonormalization and the rotations, and are released as soon as these
+ * change them by more than the locking threshold, when the precision is tightened,
+ * or before convergence is accepted.
  */
 json GroundStateSolver::optimize(Molecule &mol, FockBuilder &F) {
     printParameters("Optimize ground state orbitals");
@@ -255,6 +270,11 @@ json GroundStateSolver::optimize(Molecule &mol, FockBuilder &F) {
     auto scaling = std::vector<double>(Phi_n.size(), 1.0);
     KAIN kain(this->history, 0, false, scaling);
 
+    // Number of consecutive small updates of each orbital, used for locking
+    std::vector<int> n_small(Phi_n.size(), 0);
+    std::vector<int> active = getActiveOrbitals(n_small);
+    double lock_prec = -1.0;
+
     DoubleVector errors = DoubleVector::Ones(Phi_n.size());
     double err_o = errors.maxCoeff();
     double err_t = errors.norm();
@@ -288,14 +308,44 @@ json GroundStateSolver::optimize(Molecule &mol, FockBuilder &F) {
             F.setup(orb_prec);
         }
 
+        // Locked orbitals are released when the precision is tightened
+        if (lock_prec > 0.0 and orb_prec < lock_prec) std::fill(n_small.begin(), n_small.end(), 0);
+        lock_prec = orb_prec;
+
+        std::vector<int> prev_active = active;
+        active = getActiveOrbitals(n_small);
+        if (active != prev_active) kain.clear();
+        bool all_active = (active.size() == Phi_n.size());
+        if (not all_active) mrcpp::print::value(1, "Locked orbitals", Phi_n.size() - active.size(), "", 0, false);
+        json_cycle["locked_orbitals"] = Phi_n.size() - active.size();
+
         // Init Helmholtz operator
         HelmholtzVector H(helm_prec, F_mat.real().diagonal());
         ComplexMatrix L_mat = H.getLambdaMatrix();
 
         // Apply Helmholtz operator
-        OrbitalVector Psi = F.buildHelmholtzArgument(orb_prec, Phi_n, F_mat, L_mat);
-        OrbitalVector Phi_np1 = H(Psi);
-        Psi.clear();
+        OrbitalVector Phi_np1;
+        if (all_active) {
+            OrbitalVector Psi = F.buildHelmholtzArgument(orb_prec, Phi_n, F_mat, L_mat);
+            Phi_np1 = H(Psi);
+            Psi.clear();
+        } else {
+            DoubleVector lambda_act(active.size());
+            for (int k = 0; k < active.size(); k++) lambda_act(k) = F_mat.real()(active[k], active[k]);
+            HelmholtzVector H_act(helm_prec, lambda_act);
+
+            OrbitalVector Psi = F.buildHelmholtzArgument(orb_prec, Phi_n, F_mat, L_mat, active);
+            OrbitalVector Phi_act = H_act(Psi);
+            Psi.clear();
+
+            // Locked orbitals are carried over unchanged
+            Phi_np1 = orbital::param_copy(Phi_n);
+            for (int i = 0; i < Phi_n.size(); i++) {
+                if (n_small[i] < this->lockIter or not mrcpp::mpi::my_orb(Phi_n[i])) continue;
+                mrcpp::cplxfunc::deep_copy(Phi_np1[i], Phi_n[i]);
+            }
+            for (int k = 0; k < active.size(); k++) Phi_np1[active[k]] = Phi_act[k];
+        }
         F.clear();
 
         // Orthonormalize
@@ -305,7 +355,17 @@ json GroundStateSolver::optimize(Molecule &mol, FockBuilder &F) {
         OrbitalVector dPhi_n = orbital::add(1.0, Phi_np1, -1.0, Phi_n);
         Phi_np1.clear();
 
-        kain.accelerate(orb_prec, Phi_n, dPhi_n);
+        if (all_active) {
+            kain.accelerate(orb_prec, Phi_n, dPhi_n);
+        } else {
+            OrbitalVector Phi_act, dPhi_act;
+            for (int i : active) {
+                Phi_act.push_back(Phi_n[i]);
+                dPhi_act.push_back(dPhi_n[i]);
+            }
+            kain.accelerate(orb_prec, Phi_act, dPhi_act);
+            for (int k = 0; k < active.size(); k++) dPhi_n[active[k]] = dPhi_act[k];
+        }
 
         // Compute errors
         errors = orbital::get_norms(dPhi_n);
@@ -313,6 +373,17 @@ json GroundStateSolver::optimize(Molecule &mol, FockBuilder &F) {
         err_t = errors.norm();
         json_cycle["mo_residual"] = err_t;
 
+        // Count small updates; for locked orbitals these come from the orthonormalization only
+        if (this->lockThrs > 0.0) {
+            for (int i = 0; i < Phi_n.size(); i++) {
+                if (errors(i) < this->lockThrs * orb_prec) {
+                    n_small[i]++;
+                } else {
+                    n_small[i] = 0;
+                }
+            }
+        }
+
         // Update orbitals
         Phi_n = orbital::add(1.0, Phi_n, 1.0, dPhi_n);
         dPhi_n.clear();
@@ -321,6 +392,7 @@ json GroundStateSolver::optimize(Molecule &mol, FockBuilder &F) {
 
         // Compute Fock matrix and energy
         if (F.getReactionOperator() != nullptr) F.getReactionOperator()->updateMOResidual(err_t);
+        F.setZoraIteration(nIter);
         F.setup(orb_prec);
         F_mat = F(Phi_n, Phi_n);
         E_n = F.trace(Phi_n, nucs);
@@ -332,6 +404,12 @@ json GroundStateSolver::optimize(Molecule &mol, FockBuilder &F) {
         auto err_p = calcPropertyError();
         converged = checkConvergence(err_o, err_p);
 
+        // Convergence is only accepted after a cycle where all orbitals were updated
+        if (converged and not all_active) {
+            std::fill(n_small.begin(), n_small.end(), 0);
+            converged = false;
+        }
+
         json_cycle["energy_terms"] = E_n.json();
         json_cycle["energy_total"] = E_n.getTotalEnergy();
         json_cycle["energy_update"] = err_p;
@@ -339,12 +417,17 @@ json GroundStateSolver::optimize(Molecule &mol, FockBuilder &F) {
         // Rotate orbitals
         if (needLocalization(nIter, converged)) {
             ComplexMatrix U_mat = orbital::localize(orb_prec, Phi_n, F_mat);
-            F.rotate(U_mat);
-            kain.clear();
+            // Orbitals that were already localized keep their operators and KAIN history
+            if (not U_mat.isIdentity()) {
+                F.rotate(U_mat);
+                kain.clear();
+                releaseMixedOrbitals(U_mat, this->lockThrs * orb_prec, n_small);
+            }
         } else if (needDiagonalization(nIter, converged)) {
             ComplexMatrix U_mat = orbital::diagonalize(orb_prec, Phi_n, F_mat);
             F.rotate(U_mat);
             kain.clear();
+            releaseMixedOrbitals(U_mat, this->lockThrs * orb_prec, n_small);
         }
 
         // Save checkpoint file
@@ -367,6 +450,7 @@ json GroundStateSolver::optimize(Molecule &mol, FockBuilder &F) {
         if (converged) break;
     }
 
+    F.setZoraIteration(-1);
     F.clear();
     mrcpp::mpi::barrier(mrcpp::mpi::comm_wrk);
 
@@ -428,4 +512,39 @@ bool GroundStateSolver::needDiagonalization(int nIter, bool converged) const {
     return diag;
 }
 
+/** @brief Indices of the orbitals that are not locked
+ *
+ * @param n_small: number of consecutive small updates of each orbital
+ *
+ * An orbital is locked after lockIter consecutive small updates. If this would
+ * lock all orbitals, they are all returned as active.
+ */
+std::vector<int> GroundStateSolver::getActiveOrbitals(const std::vector<int> &n_small) const {
+    std::vector<int> active;
+    for (int i = 0; i < n_small.size(); i++) {
+        if (this->lockThrs < 0.0 or n_small[i] < this->lockIter) active.push_back(i);
+    }
+    if (active.empty()) {
+        active.resize(n_small.size());
+        std::iota(active.begin(), active.end(), 0);
+    }
+    return active;
+}
+
+/** @brief Release locked orbitals that are mixed by a rotation
+ *
+ * @param U: orbital rotation matrix
+ * @param thrs: largest allowed admixture of other orbitals
+ * @param n_small: number of consecutive small updates of each orbital
+ *
+ * The admixture is the norm of the off-diagonal part of column i of U.
+ */
+void GroundStateSolver::releaseMixedOrbitals(const ComplexMatrix &U, double thrs, std::vector<int> &n_small) const {
+    if (this->lockThrs < 0.0) return;
+    for (int i = 0; i < n_small.size(); i++) {
+        double mix = std::sqrt(std::max(0.0, U.col(i).squaredNorm() - std::norm(U(i, i))));
+        if (mix > thrs) n_small[i] = 0;
+    }
+}
+
 } // namespace mrchem
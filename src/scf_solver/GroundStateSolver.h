@@ -58,13 +58,19 @@ public:
     void setRotation(int iter) { this->rotation = iter; }
     void setLocalize(bool loc) { this->localize = loc; }
     void setCheckpointFile(const std::string &file) { this->chkFile = file; }
+    void setOrbitalLocking(double thrs, int iter) {
+        this->lockThrs = thrs;
+        this->lockIter = iter;
+    }
 
     nlohmann::json optimize(Molecule &mol, FockBuilder &F);
 
 protected:
-    int rotation{0};      ///< Number of iterations between localization/diagonalization
-    bool localize{false}; ///< Use localized or canonical orbitals
-    std::string chkFile;  ///< Name of checkpoint file
+    int rotation{0};       ///< Number of iterations between localization/diagonalization
+    bool localize{false};  ///< Use localized or canonical orbitals
+    double lockThrs{-1.0}; ///< Lock orbitals with updates below lockThrs * precision (negative: off)
+    int lockIter{3};       ///< Number of consecutive small updates before an orbital is locked
+    std::string chkFile;   ///< Name of checkpoint file
     std::vector<SCFEnergy> energy;
 
     void reset() override;
@@ -74,6 +80,8 @@ protected:
 
     bool needLocalization(int nIter, bool converged) const;
     bool needDiagonalization(int nIter, bool converged) const;
+    std::vector<int> getActiveOrbitals(const std::vector<int> &n_small) const;
+    void releaseMixedOrbitals(const ComplexMatrix &U, double thrs, std::vector<int> &n_small) const;
 };
 
 } // namespace mrchem
@@ -13,6 +13,7 @@
 #include <vector>
 #include "qmoperators/one_electron/NuclearGradientOperator.h"
 
+#include "chemistry/CellList.h"
 #include "chemistry/Molecule.h"
 #include "chemistry/Nucleus.h"
 #include "chemistry/PhysicalConstants.h"
@@ -28,8 +29,10 @@
 #include "qmoperators/one_electron/HessianOperator.h"
 #include "tensor/RankOneOperator.h"
 
+#include "surface_forces/gridEvaluation.h"
 #include "surface_forces/lebedev.h"
 #include "surface_forces/xcStress.h"
+#include "utils/math_utils.h"
 #include <string>
 #include <iostream>
 #include <filesystem>
@@ -101,16 +104,7 @@ mrcpp::ComplexFunction calcPotential(Density &rho, mrcpp::PoissonOperator &poiss
  * @param gridPos The positions of the grid points where the field should be evaluated. Shape (nGrid, 3).
 */
 MatrixXd electronicEfield(mrchem::OrbitalVector &negEfield, const MatrixXd &gridPos) {
-    int nGrid = gridPos.rows();
-    MatrixXd Efield = MatrixXd::Zero(nGrid, 3);
-    for (int i = 0; i < nGrid; i++)
-    {
-        std::array<double, 3> pos = {gridPos(i, 0), gridPos(i, 1), gridPos(i, 2)};
-        Efield(i, 0) = -negEfield[0].real().evalf(pos);
-        Efield(i, 1) = -negEfield[1].real().evalf(pos);
-        Efield(i, 2) = -negEfield[2].real().evalf(pos);
-    }
-    return Efield;
+    return -evaluateOnGrid({&negEfield[0].real(), &negEfield[1].real(), &negEfield[2].real()}, gridPos);
 }
 
 /**
@@ -161,9 +155,12 @@ std::vector<Eigen::Matrix3d> maxwellStress(const Molecule &mol, mrchem::OrbitalV
 
 /**
  * @brief Calculates the kinetic stress tensor for the given molecule. See the function description for the formula.
+ *
+ * Only the orbitals owned by this MPI rank contribute to the orbital term, and the density
+ * term is only included if addDensityTerm is set. The full stress is the sum over all ranks.
 */
 std::vector<Matrix3d> kineticStress(const Molecule &mol, OrbitalVector &Phi, std::vector<std::vector<mrchem::Orbital>> &nablaPhi
-        , std::vector<Orbital> &hessRho, double prec, const MatrixXd &gridPos){
+        , std::vector<Orbital> &hessRho, double prec, const MatrixXd &gridPos, bool addDensityTerm){
 
     // original formula for kinetic stress:
     // sigma_ij = 0.5 \sum_k phi_k del_i del_j phi_k - (del_i phi_k) (del_j phi_k)
@@ -172,50 +169,32 @@ std::vector<Matrix3d> kineticStress(const Molecule &mol, OrbitalVector &Phi, std
     // That way, only second derivatives of density is needed which speeds things up. quite a lot.
 
     int nGrid = gridPos.rows();
-    int nOrbs = Phi.size();
 
-    double StressArray[nGrid][3][3];
-
-    double orbVal;
     std::vector<Matrix3d> stress(nGrid);
 
     Eigen::MatrixXd voigtStress = Eigen::MatrixXd::Zero(nGrid, 6);
 
-    std::array<double, 3> pos;
-    double n1, n2, n3;
-    int occ;
     for (int iOrb = 0; iOrb < Phi.size(); iOrb++) {
-        occ = Phi[iOrb].occ();
-    
+        if (not mrcpp::mpi::my_orb(iOrb)) continue;
+        double occ = Phi[iOrb].occ();
+        MatrixXd nablaPhiGrid = evaluateOnGrid({&nablaPhi[iOrb][0].real(), &nablaPhi[iOrb][1].real(), &nablaPhi[iOrb][2].real()}, gridPos);
         for (int i = 0; i < nGrid; i++) {
-            if (mrcpp::mpi::my_orb(iOrb)) {  
-            pos[0] = gridPos(i, 0);
-            pos[1] = gridPos(i, 1);
-            pos[2] = gridPos(i, 2);
-            n1 = nablaPhi[iOrb][0].real().evalf(pos);
-            n2 = nablaPhi[iOrb][1].real().evalf(pos);
-            n3 = nablaPhi[iOrb][2].real().evalf(pos);
+            double n1 = nablaPhiGrid(i, 0);
+            double n2 = nablaPhiGrid(i, 1);
+            double n3 = nablaPhiGrid(i, 2);
             voigtStress(i, 0) -= occ * n1 * n1;
             voigtStress(i, 1) -= occ * n2 * n2;
             voigtStress(i, 2) -= occ * n3 * n3;
             voigtStress(i, 5) -= occ * n1 * n2;
             voigtStress(i, 4) -= occ * n1 * n3;
             voigtStress(i, 3) -= occ * n2 * n3;
-            }
-
         }
     }
-    mrcpp::mpi::allreduce_matrix(voigtStress, mrcpp::mpi::comm_wrk);
-    for (int i = 0; i < nGrid; i++) {
-        pos[0] = gridPos(i, 0);
-        pos[1] = gridPos(i, 1);
-        pos[2] = gridPos(i, 2);
-        voigtStress(i, 0) += 0.25 * hessRho[0].real().evalf(pos);
-        voigtStress(i, 1) += 0.25 * hessRho[1].real().evalf(pos);
-        voigtStress(i, 2) += 0.25 * hessRho[2].real().evalf(pos);
-        voigtStress(i, 3) += 0.25 * hessRho[3].real().evalf(pos);
-        voigtStress(i, 4) += 0.25 * hessRho[4].real().evalf(pos);
-        voigtStress(i, 5) += 0.25 * hessRho[5].real().evalf(pos);
+
+    if (addDensityTerm) {
+        std::vector<const mrcpp::FunctionTree<3> *> hessRhoTrees;
+        for (auto &h : hessRho) hessRhoTrees.push_back(&h.real());
+        voigtStress += 0.25 * evaluateOnGrid(hessRhoTrees, gridPos);
     }
 
     for (int i = 0; i < nGrid; i++) {
@@ -227,28 +206,22 @@ std::vector<Matrix3d> kineticStress(const Molecule &mol, OrbitalVector &Phi, std
 }
 
 /**
- * Calculates the distance to the nearest neighbor for each point in the given position matrix.
+ * Calculates the distance to the nearest neighbor for each nucleus.
  *
- * @param pos The matrix containing the positions of the points. Shape (nPoints, 3).
- * @return A vector containing the distances to the nearest neighbor for each point.
+ * @param nucs The nuclei of the molecule.
+ * @return A vector containing the distances to the nearest neighbor for each nucleus.
  */
-VectorXd distanceToNearestNeighbour(MatrixXd pos){
-    int n = pos.rows();
+VectorXd distanceToNearestNeighbour(const Nuclei &nucs){
+    int n = nucs.size();
     VectorXd dist(n);
-    double temp;
     if (n == 1){
         dist(0) = 1.0;
     } else {
+        // cell size of the order of a bond length
+        CellList cells(nucs, 4.0);
         for (int i = 0; i < n; i++){
-            dist(i) = (pos.row(i) - pos.row((i + 1) % n)).norm();
-            for (int j = 0; j < n; j++){
-                if (i != j){
-                    temp = (pos.row(i) - pos.row(j)).norm();
-                    if (temp < dist(i)){
-                        dist(i) = temp;
-                    }
-                }
-            }
+            int j = cells.getNearest(nucs[i].getCoord(), i);
+            dist(i) = math_utils::calc_distance(nucs[i].getCoord(), nucs[j].getCoord());
         }
     }
     return dist;
@@ -338,18 +311,33 @@ Eigen::MatrixXd surface_forces(mrchem::Molecule &mol, mrchem::OrbitalVector &Phi
 
     std::shared_ptr<mrcpp::FunctionTreeVector<3>> xc_pot_vector = xc_op->getPotential()->getPotentialVector();
 
+    // densities (and gradients) entering the xc stress, shared by all spheres
+    mrchem::Density rhoA(false);
+    mrchem::Density rhoB(false);
+    std::vector<const mrcpp::FunctionTree<3> *> xcRho;
+    if (xc_spin) {
+        std::vector<mrchem::Density *> rhoAB = {&rhoA, &rhoB};
+        mrchem::density::compute(prec, rhoAB, Phi, {DensityType::Alpha, DensityType::Beta});
+        xcRho = {&rhoA.real(), &rhoB.real()};
+    } else {
+        xcRho = {&rho.real()};
+    }
+    std::vector<Orbital> nablaRho;
+    std::vector<const mrcpp::FunctionTree<3> *> xcNablaRho;
+    if (mrdft_p->functional().isGGA()) {
+        if (xc_spin) {
+            nablaRho = nabla(rhoA);
+            for (auto &n : nabla(rhoB)) nablaRho.push_back(n);
+        } else {
+            nablaRho = nabla(rho);
+        }
+        for (auto &n : nablaRho) xcNablaRho.push_back(&n.real());
+    }
+
     int numAtoms = mol.getNNuclei();
 
     std::array<double, 3> coord;
-
-    Eigen::MatrixXd posmatrix = Eigen::MatrixXd::Zero(numAtoms, 3);
-    for (int i = 0; i < numAtoms; i++) {
-        coord = mol.getNuclei()[i].getCoord();
-        posmatrix(i, 0) = coord[0];
-        posmatrix(i, 1) = coord[1];
-        posmatrix(i, 2) = coord[2];
-    }
-    VectorXd dist = distanceToNearestNeighbour(posmatrix);
+    VectorXd dist = distanceToNearestNeighbour(mol.getNuclei());
 
     int nLebPoints = 0;
     int nTinyPoints = 1;
@@ -370,7 +358,10 @@ Eigen::MatrixXd surface_forces(mrchem::Molecule &mol, mrchem::OrbitalVector &Phi
     Vector3d center;
     Eigen::MatrixXd forces = Eigen::MatrixXd::Zero(numAtoms, 3);
 
+    // The orbital part of the kinetic stress is split by orbital ownership, the
+    // remaining (density) terms by atom. Partial forces are summed at the end.
     for (int iAtom = 0; iAtom < numAtoms; iAtom++) {
+        bool myAtom = (iAtom % mrcpp::mpi::wrk_size == mrcpp::mpi::wrk_rank);
         radius = dist(iAtom) * radius_factor;
         coord = mol.getNuclei()[iAtom].getCoord();
         center << coord[0], coord[1], coord[2];
@@ -379,18 +370,18 @@ Eigen::MatrixXd surface_forces(mrchem::Molecule &mol, mrchem::OrbitalVector &Phi
         MatrixXd gridPos = integrator.getPoints();
         VectorXd weights = integrator.getWeights();
         MatrixXd normals = integrator.getNormals();
-        std::vector<Matrix3d> xcStress = getXCStress(mrdft_p, *xc_pot_vector, std::make_shared<mrchem::OrbitalVector>(Phi), 
-            std::make_shared<mrchem::NablaOperator>(nabla), gridPos, xc_spin, prec);
-        
-        
-        std::vector<Matrix3d> kstress = kineticStress(mol, Phi, nablaPhi, hessRho, prec, gridPos);
-        std::vector<Matrix3d> mstress = maxwellStress(mol, negEfield, gridPos, prec);
-        std::vector<Matrix3d> stress(integrator.n);
+
+        std::vector<Matrix3d> stress = kineticStress(mol, Phi, nablaPhi, hessRho, prec, gridPos, myAtom);
+        if (myAtom) {
+            std::vector<Matrix3d> xcStress = getXCStress(mrdft_p, *xc_pot_vector, xcRho, xcNablaRho, gridPos, xc_spin);
+            std::vector<Matrix3d> mstress = maxwellStress(mol, negEfield, gridPos, prec);
+            for (int i = 0; i < integrator.n; i++) stress[i] += xcStress[i] + mstress[i];
+        }
         for (int i = 0; i < integrator.n; i++){
-            stress[i] = xcStress[i] + kstress[i] + mstress[i];
             forces.row(iAtom) -= stress[i] * normals.row(i).transpose() * weights(i);
         }
     }
+    mrcpp::mpi::allreduce_matrix(forces, mrcpp::mpi::comm_wrk);
 
     hess.clear();
     nabla.clear();
@@ -0,0 +1,92 @@
+#include "surface_forces/gridEvaluation.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <numeric>
+
+using namespace Eigen;
+
+namespace surface_force {
+
+namespace {
+
+/**
+ * @brief Interleave the lowest 10 bits of x with two zero bits between each bit.
+ */
+uint32_t spreadBits(uint32_t x) {
+    x &= 0x000003ff;
+    x = (x | (x << 16)) & 0xff0000ff;
+    x = (x | (x << 8)) & 0x0300f00f;
+    x = (x | (x << 4)) & 0x030c30c3;
+    x = (x | (x << 2)) & 0x09249249;
+    return x;
+}
+
+/**
+ * @brief Order the grid points along a Morton (Z-order) curve over their bounding box.
+ *
+ * Points that are close in space end up close in the returned ordering, so
+ * consecutive evaluations descend through the same tree nodes and find them
+ * in cache. Each thread also gets a spatially compact block of points.
+ */
+std::vector<int> spatialOrdering(const MatrixXd &gridPos) {
+    int nGrid = gridPos.rows();
+    std::vector<int> order(nGrid);
+    std::iota(order.begin(), order.end(), 0);
+    if (nGrid < 2) return order;
+
+    Vector3d lower = gridPos.colwise().minCoeff();
+    Vector3d upper = gridPos.colwise().maxCoeff();
+    Vector3d scale;
+    for (int d = 0; d < 3; d++) {
+        double width = upper(d) - lower(d);
+        scale(d) = (width > 0.0) ? 1023.0 / width : 0.0;
+    }
+
+    std::vector<uint32_t> keys(nGrid);
+    for (int i = 0; i < nGrid; i++) {
+        uint32_t key = 0;
+        for (int d = 0; d < 3; d++) {
+            auto cell = static_cast<uint32_t>((gridPos(i, d) - lower(d)) * scale(d));
+            key |= spreadBits(cell) << d;
+        }
+        keys[i] = key;
+    }
+    std::sort(order.begin(), order.end(), [&keys](int a, int b) { return keys[a] < keys[b]; });
+    return order;
+}
+
+} // namespace
+
+/**
+ * @brief Evaluate a set of functions on a set of grid points.
+ *
+ * All functions are evaluated together at each point, with the points visited
+ * in spatial order and distributed over OpenMP threads. Each evaluation is a
+ * plain FunctionTree::evalf, i.e. a full descent from the root per point and
+ * function. The spatial order only makes these descents hit cached nodes; the
+ * points are not grouped by end node.
+ *
+ * @param funcs The functions to evaluate, all must be defined on the same MRA.
+ * @param gridPos The positions of the grid points. Shape (nGrid, 3).
+ * @return The function values. Shape (nGrid, nFuncs).
+ */
+MatrixXd evaluateOnGrid(const std::vector<const mrcpp::FunctionTree<3> *> &funcs, const MatrixXd &gridPos) {
+    int nGrid = gridPos.rows();
+    int nFuncs = funcs.size();
+    MatrixXd values = MatrixXd::Zero(nGrid, nFuncs);
+    if (nGrid == 0 or nFuncs == 0) return values;
+
+    std::vector<int> order = spatialOrdering(gridPos);
+
+#pragma omp parallel for schedule(static)
+    for (int n = 0; n < nGrid; n++) {
+        int i = order[n];
+        std::array<double, 3> pos = {gridPos(i, 0), gridPos(i, 1), gridPos(i, 2)};
+        for (int j = 0; j < nFuncs; j++) values(i, j) = funcs[j]->evalf(pos);
+    }
+    return values;
+}
+
+} // namespace surface_force
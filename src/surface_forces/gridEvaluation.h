@@ -0,0 +1,11 @@
+#pragma once
+
+#include <Eigen/Core>
+#include <MRCPP/MWFunctions>
+#include <vector>
+
+namespace surface_force {
+
+Eigen::MatrixXd evaluateOnGrid(const std::vector<const mrcpp::FunctionTree<3> *> &funcs, const Eigen::MatrixXd &gridPos);
+
+} // namespace surface_force
@@ -6,6 +6,7 @@
 #include "qmfunctions/Density.h"
 #include "qmfunctions/density_utils.h"
 #include "qmoperators/one_electron/NablaOperator.h"
+#include "surface_forces/gridEvaluation.h"
 
 using namespace Eigen;
 using namespace mrchem;
@@ -74,14 +75,11 @@ std::vector<Matrix3d> xcGGAStress(unique_ptr<mrdft::MRDFT> &mrdft_p, mrcpp::Func
     inp.col(3) = nablaRhoGrid.col(2);
     Eigen::MatrixXd xcOUT =  mrdft_p->functional().evaluate_transposed(inp);
     std::vector<Matrix3d> out(nGrid);
-    std::array<double, 3> pos;
+    MatrixXd vxcGrid = evaluateOnGrid({std::get<1>(xc_pots[0])}, gridPos);
     for (int i = 0; i < rhoGrid.rows(); i++) {
         out[i] = Matrix3d::Zero();
-        pos[0] = gridPos(i, 0);
-        pos[1] = gridPos(i, 1);
-        pos[2] = gridPos(i, 2);
         for (int j = 0; j < 3; j++) {
-            out[i](j, j) = xcOUT(i, 0) - rhoGrid(i) * std::get<1>(xc_pots[0])->evalf(pos);
+            out[i](j, j) = xcOUT(i, 0) - rhoGrid(i) * vxcGrid(i, 0);
         }
         for (int j1 = 0; j1 < 3; j1++) {
             for (int j2 = 0; j2 < 3; j2++) {
@@ -115,14 +113,11 @@ std::vector<Matrix3d> xcGGASpinStress(unique_ptr<mrdft::MRDFT> &mrdft_p, mrcpp::
     inp.col(6) = nablaRhoGridBeta.col(1);
     inp.col(7) = nablaRhoGridBeta.col(2);
     Eigen::MatrixXd xc = mrdft_p->functional().evaluate_transposed(inp);
-    std::array<double, 3> pos;
+    MatrixXd vxcGrid = evaluateOnGrid({std::get<1>(xc_pots[0]), std::get<1>(xc_pots[1])}, gridPos);
     for (int i = 0; i < rhoGridAlpha.rows(); i++) {
         out[i] = Matrix3d::Zero();
-        pos[0] = gridPos(i, 0);
-        pos[1] = gridPos(i, 1);
-        pos[2] = gridPos(i, 2);
         for (int j = 0; j < 3; j++) {
-            out[i](j, j) = xc(i, 0) - std::get<1>(xc_pots[0])->evalf(pos) * rhoGridAlpha(i) - std::get<1>(xc_pots[1])->evalf(pos) * rhoGridBeta(i);
+            out[i](j, j) = xc(i, 0) - vxcGrid(i, 0) * rhoGridAlpha(i) - vxcGrid(i, 1) * rhoGridBeta(i);
         }
         for (int j1 = 0; j1 < 3; j1++) {
             for (int j2 = 0; j2 < 3; j2++) {
@@ -136,16 +131,19 @@ std::vector<Matrix3d> xcGGASpinStress(unique_ptr<mrdft::MRDFT> &mrdft_p, mrcpp::
 
 /**
  * @brief Compute the exchange-correlation stress tensor on a grid
- * 
+ *
+ * The densities and their gradients are computed once by the caller and
+ * reused for every integration sphere.
+ *
  * @param mrdft_p MRDFT object
- * @param phi OrbitalVector
- * @param nabla NablaOperator (must be set up prior to calling this function)
+ * @param xc_pots XC potentials from the XCOperator
+ * @param rho Density trees: total density, or alpha and beta density if open shell
+ * @param nablaRho Gradient trees of the densities in rho, three per density (only used for GGA)
  * @param gridPos MatrixXd with grid positions, shape (nGrid, 3)
  * @param isOpenShell bool, true if open shell calculation
- * @param prec precision to use in density representation
  */
-std::vector<Eigen::Matrix3d> getXCStress(unique_ptr<mrdft::MRDFT> &mrdft_p, mrcpp::FunctionTreeVector<3> &xc_pots, std::shared_ptr<OrbitalVector> phi,
-        std::shared_ptr<NablaOperator> nabla, MatrixXd &gridPos, bool isOpenShell, double prec){
+std::vector<Eigen::Matrix3d> getXCStress(unique_ptr<mrdft::MRDFT> &mrdft_p, mrcpp::FunctionTreeVector<3> &xc_pots, const std::vector<const mrcpp::FunctionTree<3> *> &rho,
+        const std::vector<const mrcpp::FunctionTree<3> *> &nablaRho, MatrixXd &gridPos, bool isOpenShell){
 
     bool isGGA = mrdft_p->functional().isGGA();
     bool isHybrid = mrdft_p->functional().isHybrid();
@@ -153,74 +151,27 @@ std::vector<Eigen::Matrix3d> getXCStress(unique_ptr<mrdft::MRDFT> &mrdft_p, mrcp
         MSG_ABORT("Exact exchange is not implemented for forces computed with surface integrals");
     }
 
-    std::array<double, 3> pos;
-    int nGrid = gridPos.rows();
-
     vector<Matrix3d> xcStress;
 
     if (isOpenShell) {
-        MatrixXd rhoGridAlpha(nGrid, 1);
-        MatrixXd rhoGridBeta(nGrid, 1);
-        mrchem::Density rhoA(false);
-        mrchem::Density rhoB(false);
-        mrchem::density::compute(prec, rhoA, *phi, DensityType::Alpha);
-        mrchem::density::compute(prec, rhoB, *phi, DensityType::Beta);
-
-        for (int i = 0; i < nGrid; i++) { // compute density on grid
-            pos[0] = gridPos(i, 0);
-            pos[1] = gridPos(i, 1);
-            pos[2] = gridPos(i, 2);
-            rhoGridAlpha(i) = rhoA.real().evalf(pos);
-            rhoGridBeta(i) = rhoB.real().evalf(pos);
-        }
+        MatrixXd rhoGridAB = evaluateOnGrid(rho, gridPos);
+        MatrixXd rhoGridAlpha = rhoGridAB.col(0);
+        MatrixXd rhoGridBeta = rhoGridAB.col(1);
 
         if (isGGA) {
-            mrchem::NablaOperator nablaOP = *nabla;
-            std::vector<mrchem::Orbital> nablaRhoAlpha = nablaOP(rhoA);
-            std::vector<mrchem::Orbital> nablaRhoBeta = nablaOP(rhoB);
-            MatrixXd nablaRhoGridAlpha(nGrid, 3);
-            MatrixXd nablaRhoGridBeta(nGrid, 3);
-            for (int i = 0; i < nGrid; i++) {
-                pos[0] = gridPos(i, 0);
-                pos[1] = gridPos(i, 1);
-                pos[2] = gridPos(i, 2);
-                nablaRhoGridAlpha(i, 0) = nablaRhoAlpha[0].real().evalf(pos);
-                nablaRhoGridAlpha(i, 1) = nablaRhoAlpha[1].real().evalf(pos);
-                nablaRhoGridAlpha(i, 2) = nablaRhoAlpha[2].real().evalf(pos);
-                nablaRhoGridBeta(i, 0) = nablaRhoBeta[0].real().evalf(pos);
-                nablaRhoGridBeta(i, 1) = nablaRhoBeta[1].real().evalf(pos);
-                nablaRhoGridBeta(i, 2) = nablaRhoBeta[2].real().evalf(pos);
-            }
-
+            MatrixXd nablaRhoGridAB = evaluateOnGrid(nablaRho, gridPos);
+            MatrixXd nablaRhoGridAlpha = nablaRhoGridAB.leftCols(3);
+            MatrixXd nablaRhoGridBeta = nablaRhoGridAB.rightCols(3);
             xcStress = xcGGASpinStress(mrdft_p, xc_pots, rhoGridAlpha, rhoGridBeta, nablaRhoGridAlpha, nablaRhoGridBeta, gridPos);
         } else {
             xcStress = xcLDASpinStress(mrdft_p, rhoGridAlpha, rhoGridBeta);
         }
 
     } else { // closed shell
-        MatrixXd rhoGrid(nGrid, 1);
-        mrchem::Density rho(false);
-        mrchem::density::compute(prec, rho, *phi, DensityType::Total);
-
-        for (int i = 0; i < nGrid; i++) { // compute density on grid
-            pos[0] = gridPos(i, 0);
-            pos[1] = gridPos(i, 1);
-            pos[2] = gridPos(i, 2);
-            rhoGrid(i) = rho.real().evalf(pos);
-        }
+        MatrixXd rhoGrid = evaluateOnGrid(rho, gridPos);
 
         if (isGGA) {
-            mrchem::NablaOperator nablaOP = *nabla;
-            std::vector<mrchem::Orbital> nablaRho = nablaOP(rho);
-            MatrixXd nablaRhoGrid(nGrid, 3);
-            for (int i = 0; i < nGrid; i++) {
-                pos[0] = gridPos(i, 0);
-                pos[1] = gridPos(i, 1);
-                pos[2] = gridPos(i, 2);
-                nablaRhoGrid(i, 0) = nablaRho[0].real().evalf(pos);
-                nablaRhoGrid(i, 1) = nablaRho[1].real().evalf(pos);
-                nablaRhoGrid(i, 2) = nablaRho[2].real().evalf(pos);
-            }
+            MatrixXd nablaRhoGrid = evaluateOnGrid(nablaRho, gridPos);
             xcStress = xcGGAStress(mrdft_p, xc_pots, rhoGrid, nablaRhoGrid, gridPos);
         } else {
             xcStress = xcLDAStress(mrdft_p, rhoGrid);
@@ -27,6 +27,10 @@
 #include <MRCPP/Timer>
 #include <MRCPP/Parallel>
 
+#ifdef MRCHEM_HAS_OMP
+#include <omp.h>
+#endif
+
 #include "RankZeroOperator.h"
 
 #include "chemistry/Nucleus.h"
@@ -39,6 +43,8 @@ using mrcpp::Timer;
 
 namespace mrchem {
 
+int RankZeroOperator::omp_orbital_nodes = 0;
+
 /** @brief return the expansion coefficients as an Eigen vector
  *
  * Converts std::vector<std::complex<double> > to Eigen::VectorXcd
@@ -284,6 +290,8 @@ Orbital RankZeroOperator::dagger(Orbital inp) {
  * the corresponding output orbitals after applying the operator.
  */
 OrbitalVector RankZeroOperator::operator()(OrbitalVector &inp) {
+    if (useOrbitalThreads(inp)) return applyOrbitalThreads(inp);
+
     RankZeroOperator &O = *this;
     OrbitalVector out;
     for (auto i = 0; i < inp.size(); i++) {
@@ -297,6 +305,74 @@ OrbitalVector RankZeroOperator::operator()(OrbitalVector &inp) {
     return out;
 }
 
+/** @brief decide whether to distribute OpenMP threads over orbitals
+ *
+ * @param inp: orbitals on which to apply
+ *
+ * For small orbitals the parallel efficiency of the individual MRCPP kernels is
+ * poor, and it is better to apply the operator to several orbitals concurrently.
+ * This is done when the average number of end nodes of the local orbitals is below
+ * omp_orbital_nodes, and all fundamental operators in the expansion are thread safe.
+ */
+bool RankZeroOperator::useOrbitalThreads(OrbitalVector &inp) const {
+    if (omp_orbital_nodes <= 0 or mrcpp::omp::n_threads < 2) return false;
+
+    int n_orbs = 0;
+    int n_nodes = 0;
+    for (auto &phi : inp) {
+        if (phi.getNNodes(NUMBER::Total) == 0) continue;
+        n_nodes += phi.getNNodes(NUMBER::Total);
+        n_orbs++;
+    }
+    if (n_orbs < 2 or n_nodes >= n_orbs * omp_orbital_nodes) return false;
+
+    for (const auto &term : this->oper_exp) {
+        for (const auto &O_nm : term) {
+            if (O_nm == nullptr or not O_nm->isThreadSafe()) return false;
+        }
+    }
+    return true;
+}
+
+/** @brief apply operator expansion to orbital vector, one thread per orbital
+ *
+ * @param inp: orbitals on which to apply
+ *
+ * Same result as operator()(OrbitalVector &), but each orbital is handled by a
+ * single OpenMP thread. Nested parallelism is disabled for the duration, so that
+ * the MRCPP kernels run serially within each orbital.
+ */
+OrbitalVector RankZeroOperator::applyOrbitalThreads(OrbitalVector &inp) {
+    RankZeroOperator &O = *this;
+    int n_orbs = inp.size();
+
+    OrbitalVector out;
+    for (auto &phi : inp) out.push_back(phi.paramCopy());
+    std::vector<Timer> timers(n_orbs);
+
+#ifdef MRCHEM_HAS_OMP
+    int n_threads = std::min(mrcpp::omp::n_threads, n_orbs);
+    int max_levels = omp_get_max_active_levels();
+    omp_set_max_active_levels(1);
+#pragma omp parallel for schedule(dynamic) num_threads(n_threads)
+#endif
+    for (int i = 0; i < n_orbs; i++) {
+        timers[i].start();
+        out[i] = O(inp[i]);
+        timers[i].stop();
+    }
+#ifdef MRCHEM_HAS_OMP
+    omp_set_max_active_levels(max_levels);
+#endif
+
+    for (int i = 0; i < n_orbs; i++) {
+        std::stringstream o_name;
+        o_name << O.name() << "|" << i << ">";
+        print_utils::qmfunction(4, o_name.str(), out[i], timers[i]);
+    }
+    return out;
+}
+
 /** @brief apply the adjoint of the operator expansion to orbital vector
  *
  * @param inp: orbitals on which to apply
@@ -109,6 +109,8 @@ public:
     RankZeroOperator &operator+=(const RankZeroOperator &O);
     RankZeroOperator &operator-=(const RankZeroOperator &O);
 
+    static int omp_orbital_nodes; ///< Thread over orbitals when their average size (end nodes) is below this, 0 disables
+
     friend RankZeroOperator operator*(ComplexDouble a, RankZeroOperator A);
     friend RankZeroOperator operator*(RankZeroOperator A, RankZeroOperator B);
     friend RankZeroOperator operator+(RankZeroOperator A, RankZeroOperator B);
@@ -119,6 +121,8 @@ protected:
     std::vector<ComplexDouble> coef_exp;
     std::vector<QMOperatorVector> oper_exp;
 
+    bool useOrbitalThreads(OrbitalVector &inp) const;
+    OrbitalVector applyOrbitalThreads(OrbitalVector &inp);
     Orbital applyOperTerm(int n, Orbital inp);
     Orbital daggerOperTerm(int n, Orbital inp);
     ComplexDouble traceOperTerm(int n, const Nuclei &nucs);
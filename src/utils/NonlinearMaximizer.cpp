@@ -42,7 +42,7 @@ namespace mrchem {
  *  can be defined in a subclass.
  */
 // We consider only the diagonal of the Hessian, until we are close to the minimum
-int NonlinearMaximizer::maximize() {
+int NonlinearMaximizer::maximize(double thrs) {
     Timer t_tot, t_hess, t_step;
     t_hess.stop();
     t_step.stop();
@@ -55,7 +55,7 @@ int NonlinearMaximizer::maximize() {
     int maxIter = 150;  // max number of iterations
     int CG_maxiter = 5; // max number of iterations for the Conjugated Gradient solver for Newton step
     bool converged = false;
-    double threshold = 1.0e-12;    // initial value. convergence when norm of gradient is smaller than threshold
+    double threshold = thrs;       // initial value. convergence when norm of gradient is smaller than threshold
     double CG_threshold = 1.0e-12; // convergence when norm of residue is smaller than threshold
     double h = 0.1;                // initial value of trust radius, should be set small enough.
     bool wrongstep = false;
@@ -77,6 +77,14 @@ int NonlinearMaximizer::maximize() {
 
     if (print > 100 and mrcpp::mpi::wrk_rank == 0) cout << "gradient " << gradient << endl;
 
+    // The starting point may already be a maximum, e.g. when the orbitals were
+    // localized in the previous SCF iteration. Then no step is taken.
+    if (gradient_norm < threshold) {
+        maxEiVal = this->get_hessian(0, 0);
+        for (i = 1; i < N2h; i++) maxEiVal = std::max(maxEiVal, this->get_hessian(i, i));
+        if (maxEiVal < 10 * std::sqrt(std::abs(threshold))) return 0;
+    }
+
     // Start of iterations
     for (iter = 1; iter < maxIter + 1 && !converged; iter++) {
         int lastICG = 0;
@@ -137,7 +145,7 @@ int NonlinearMaximizer::maximize() {
         if (mu < mu_min * 1.1) {
             newton_step = 1;
             N_newton_step++;
-            if (N_newton_step > 5) threshold = 1.0e-11;
+            if (N_newton_step > 5) threshold = std::max(thrs, 1.0e-11);
             if ((N_newton_step > 2 && (step_norm2 < 1.E-3 || newton_step_exact == 1))) {
                 if (print > 10 and mrcpp::mpi::wrk_rank == 0) cout << "Taking Newton step  " << endl;
                 newton_step_exact = 1;
@@ -43,7 +43,7 @@ namespace mrchem {
 class NonlinearMaximizer {
 public:
     NonlinearMaximizer(){};
-    int maximize();
+    int maximize(double thrs = 1.0e-12);
 
 protected:
     int N2h{0}; // size (for orbital localization: N2h = N*(N-1)/2)
@@ -1,6 +1,10 @@
 #include <Eigen/Dense>
 #include "PolyInterpolator.h"
 
+#include <array>
+
+#include <MRCPP/Printer>
+
 namespace interpolation_utils{
 double polynomialInterpolate5(Eigen::VectorXd &x_in, Eigen::VectorXd &y_in, double x){
     double xm2 = x_in(0);
@@ -79,4 +83,63 @@ int binarySearch(const Eigen::VectorXd &x, const double &x0) {
     }
     return i;
 }
-} // namespace interpolation_utils
\ No newline at end of file
+PolyInterpolator::PolyInterpolator(const Eigen::VectorXd &x_in, const Eigen::VectorXd &y_in) {
+    x = x_in;
+    y = y_in;
+    n = x_in.size();
+    if (n < 5) MSG_ABORT("At least 5 points are needed for interpolation");
+    xmin = x_in(0);
+    xmax = x_in(x_in.size() - 1);
+    Eigen::VectorXd x_in_poly(5), y_in_poly(5);
+
+    int j = 0;
+    for (int i = n - 5; i < n; i++) {
+        x_in_poly(j) = x(i);
+        y_in_poly(j) = y(i);
+        j++;
+    }
+    ypxmax = polynomialInterpolate5_deriv(x_in_poly, y_in_poly, xmax);
+    for (int i = 0; i < 5; i++) {
+        x_in_poly(i) = x(i);
+        y_in_poly(i) = y(i);
+    }
+    ypxmin = polynomialInterpolate5_deriv(x_in_poly, y_in_poly, xmin);
+
+    // Monomial coefficients in t = x - x(c) of the polynomial through x(c - 2), ..., x(c + 2),
+    // obtained from the Newton form by multiplying in one node at a time
+    coefs = Eigen::MatrixXd::Zero(5, n - 1);
+    centers = Eigen::VectorXd::Zero(n - 1);
+    for (int i = 0; i < n - 1; i++) {
+        int c = adjustIndexToBoundaries(i);
+        std::array<double, 5> t, dd;
+        for (int k = 0; k < 5; k++) {
+            t[k] = x(c - 2 + k) - x(c);
+            dd[k] = y(c - 2 + k);
+        }
+        for (int l = 1; l < 5; l++) {
+            for (int k = 4; k >= l; k--) dd[k] = (dd[k] - dd[k - 1]) / (t[k] - t[k - l]);
+        }
+        // Horner scheme on the Newton form: p = dd[4]; p = p * (t - t[k]) + dd[k]
+        std::array<double, 5> p{dd[4], 0.0, 0.0, 0.0, 0.0};
+        for (int k = 3; k >= 0; k--) {
+            for (int m = 4; m > 0; m--) p[m] = p[m - 1] - t[k] * p[m];
+            p[0] = dd[k] - t[k] * p[0];
+        }
+        for (int m = 0; m < 5; m++) coefs(m, i) = p[m];
+        centers(i) = x(c);
+    }
+
+    // Lookup table of the first interval in each bucket of the mapped variable
+    lookupScale = x(1) - x(0);
+    int nBuckets = 4 * n;
+    lookupStep = nBuckets / std::log1p((xmax - xmin) / lookupScale);
+    buckets.resize(nBuckets);
+    int i = 0;
+    for (int b = 0; b < nBuckets; b++) {
+        double x_b = xmin + lookupScale * std::expm1(b / lookupStep);
+        while (i < n - 2 and x_b >= x(i + 1)) i++;
+        buckets[b] = i;
+    }
+}
+
+} // namespace interpolation_utils
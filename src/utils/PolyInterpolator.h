@@ -1,4 +1,6 @@
 #pragma once
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <Eigen/Dense>
 #include <fstream>
@@ -33,6 +35,12 @@ int binarySearch(const Eigen::VectorXd &x, const double &x0);
 
 /**
  * @brief Class to interpolate a functions using a 5th order polynomials.
+ *
+ * The polynomial through the 5 grid points around each interval is computed once in the
+ * constructor and stored as coefficients in the distance to the stencil center. The interval
+ * containing a point is found from a lookup table on a logarithmic mapping of the grid
+ * (the tabulated radial grids are close to exponential), so that evaluation requires
+ * neither a binary search nor any memory allocation.
  */
 class PolyInterpolator {
     Eigen::VectorXd x;
@@ -50,55 +58,40 @@ class PolyInterpolator {
      */
     double ypxmin;
 
+    /**
+     * @brief Polynomial coefficients for each interval, shape (5, n - 1), lowest order first.
+     */
+    Eigen::MatrixXd coefs;
+
+    /**
+     * @brief Center of the interpolation stencil of each interval, shape (n - 1).
+     */
+    Eigen::VectorXd centers;
+
+    /**
+     * @brief First interval of each bucket of the lookup table
+     */
+    std::vector<int> buckets;
+    double lookupScale; ///< Length scale of the logarithmic mapping log(1 + (x - xmin) / lookupScale)
+    double lookupStep;  ///< Inverse bucket width in the mapped variable
+
     public:
     /**
      * @brief Constructor
-     * @param x_in x values of the points to interpolate
+     * @param x_in x values of the points to interpolate, strictly increasing
      * @param y_in y values of the points to interpolate
      */
-    PolyInterpolator(Eigen::VectorXd &x_in, Eigen::VectorXd &y_in){
-        x = x_in;
-        y = y_in;
-        n = x_in.size();
-        xmin = x_in(0);
-        xmax = x_in(x_in.size() - 1);
-        Eigen::VectorXd x_in_poly(5), y_in_poly(5);
-
-        int j = 0;
-        for (int i = n - 5; i < n; i++) {
-            x_in_poly(j) = x(i);
-            y_in_poly(j) = y(i);
-            j++;
-        }
-        ypxmax = polynomialInterpolate5_deriv(x_in_poly, y_in_poly, xmax);
-        for (int i = 0; i < 5; i++) {
-            x_in_poly(i) = x(i);
-            y_in_poly(i) = y(i);
-        }
-        ypxmin = polynomialInterpolate5_deriv(x_in_poly, y_in_poly, xmin);
-    }
-    
+    PolyInterpolator(const Eigen::VectorXd &x_in, const Eigen::VectorXd &y_in);
+
     /**
      * @brief Evaluate the interpolated function at x. 
      * No extrapolation for x < xmin (meaning that the polynomial is evaluated at x < xmin), linear extrapolation for x > xmax.
      * Useful when the logarithm of the density is interpolated.
      * @param x x value at which to evaluate the function
      */
-    double evalfLeftNoRightLinear(const double &xval) const{
-        double y;
-        if (xval > xmax) { // linear extrapolation
-                y = this->y(n - 1) + ypxmax*(xval - xmax);
-            return y;
-        }
-
-        Eigen::VectorXd x_in_poly(5), y_in_poly(5);
-        int i = adjustIndexToBoundaries(binarySearch(this->x, xval));
-        for (int k = 0; k < 5; k++) {
-            x_in_poly(k) = this->x(i - 2 + k);
-            y_in_poly(k) = this->y(i - 2 + k);
-        }
-        y = polynomialInterpolate5(x_in_poly, y_in_poly, xval);
-        return y;
+    double evalfLeftNoRightLinear(const double &xval) const {
+        if (xval > xmax) return this->y(n - 1) + ypxmax * (xval - xmax);
+        return interpolate(xval);
     }
 
     /**
@@ -107,22 +100,9 @@ class PolyInterpolator {
      * Useful when the density is interpolated.
      * @param x x value at which to evaluate the function
      */
-    double evalfLeftNoRightZero(const double &xval) const{
-        double y;
-        if (xval > xmax) { // constant
-            y = 0.0;
-            return y;
-        }
-
-        Eigen::VectorXd x_in_poly(5), y_in_poly(5);
-        int j = adjustIndexToBoundaries(binarySearch(this->x, xval));
-        int i = adjustIndexToBoundaries(binarySearch(this->x, xval));
-        for (int k = 0; k < 5; k++) {
-            x_in_poly(k) = this->x(i - 2 + k);
-            y_in_poly(k) = this->y(i - 2 + k);
-        }
-        y = polynomialInterpolate5(x_in_poly, y_in_poly, xval);
-        return y;
+    double evalfLeftNoRightZero(const double &xval) const {
+        if (xval > xmax) return 0.0;
+        return interpolate(xval);
     }
 
     /**
@@ -130,20 +110,23 @@ class PolyInterpolator {
      * No extrapolation for x < xmin (meaning that the polynomial is evaluated at x < xmin), the last value is returned for x > xmax.
      */
     double evalfLeftNoRightConstant(const double &xval) const {
-        double y;
-        if (xval > xmax) { // constant
-            y = this->y(n - 1);
-            return y;
-        }
-
-        Eigen::VectorXd x_in_poly(5), y_in_poly(5);
-        int i = adjustIndexToBoundaries(binarySearch(this->x, xval));
-        for (int k = 0; k < 5; k++) {
-            x_in_poly(k) = this->x(i - 2 + k);
-            y_in_poly(k) = this->y(i - 2 + k);
-        }
-        y = polynomialInterpolate5(x_in_poly, y_in_poly, xval);
-        return y;
+        if (xval > xmax) return this->y(n - 1);
+        return interpolate(xval);
+    }
+
+    /**
+     * @brief Batched versions of the above, evaluating at all values in xval.
+     * @param xval x values at which to evaluate the function
+     * @param yval output values, must have the same size as xval
+     */
+    void evalfLeftNoRightLinear(const Eigen::Ref<const Eigen::VectorXd> &xval, Eigen::Ref<Eigen::VectorXd> yval) const {
+        for (int k = 0; k < xval.size(); k++) yval(k) = evalfLeftNoRightLinear(xval(k));
+    }
+    void evalfLeftNoRightZero(const Eigen::Ref<const Eigen::VectorXd> &xval, Eigen::Ref<Eigen::VectorXd> yval) const {
+        for (int k = 0; k < xval.size(); k++) yval(k) = evalfLeftNoRightZero(xval(k));
+    }
+    void evalfLeftNoRightConstant(const Eigen::Ref<const Eigen::VectorXd> &xval, Eigen::Ref<Eigen::VectorXd> yval) const {
+        for (int k = 0; k < xval.size(); k++) yval(k) = evalfLeftNoRightConstant(xval(k));
     }
 
     private: 
@@ -155,5 +138,27 @@ class PolyInterpolator {
         if (i == n - 2) j = n - 3;
         return j;
     }
+
+    /**
+     * @brief Index i of the interval with x(i) <= xval < x(i + 1), clamped to [0, n - 2].
+     */
+    int findInterval(double xval) const {
+        if (xval <= xmin) return 0;
+        int b = static_cast<int>(std::log1p((xval - xmin) / lookupScale) * lookupStep);
+        int i = buckets[std::min(b, static_cast<int>(buckets.size()) - 1)];
+        while (i > 0 and xval < this->x(i)) i--; // guard against rounding in the mapping
+        while (i < n - 2 and xval >= this->x(i + 1)) i++;
+        return i;
+    }
+
+    /**
+     * @brief Evaluate the stored polynomial of the interval containing xval.
+     */
+    double interpolate(double xval) const {
+        int i = findInterval(xval);
+        double t = xval - this->centers(i);
+        const double *c = this->coefs.col(i).data();
+        return c[0] + t * (c[1] + t * (c[2] + t * (c[3] + t * c[4])));
+    }
 };    
-} // namespace interpolation_utils
\ No newline at end of file
+} // namespace interpolation_utils
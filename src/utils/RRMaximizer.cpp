@@ -26,6 +26,8 @@
 #include "MRCPP/Printer"
 #include <unsupported/Eigen/MatrixFunctions> // faster exponential of matrices
 
+#include <numeric>
+
 #include "utils/RRMaximizer.h"
 #include "utils/math_utils.h"
 
@@ -120,6 +122,25 @@ RRMaximizer::RRMaximizer(double prec, OrbitalVector &Phi) {
     }
 }
 
+/** Set up from the position matrices <i|R_x|j>,<i|R_y|j>,<i|R_z|j> of orthonormal orbitals
+ */
+RRMaximizer::RRMaximizer(const DoubleMatrix &R_x, const DoubleMatrix &R_y, const DoubleMatrix &R_z) {
+    this->N = R_x.rows();
+    if (this->N < 2) MSG_ERROR("Cannot localize less than two orbitals");
+
+    this->total_U = DoubleMatrix::Identity(this->N, this->N);
+    this->N2h = this->N * (this->N - 1) / 2;
+    this->gradient = DoubleVector(this->N2h);
+    this->r_i_orig = DoubleMatrix::Zero(this->N, 3 * this->N);
+
+    const DoubleMatrix *R[3] = {&R_x, &R_y, &R_z};
+    for (int d = 0; d < 3; d++) {
+        if (R[d]->rows() != this->N or R[d]->cols() != this->N) MSG_ERROR("Invalid position matrix");
+        this->r_i_orig.middleCols(d * this->N, this->N) = 0.5 * (*R[d] + R[d]->transpose()); // Enforce symmetry
+    }
+    this->r_i = this->r_i_orig;
+}
+
 /** compute the value of
  * f$  \sum_{i=1,N}\langle i| {\bf R}| i \rangle^2\f$
  */
@@ -334,4 +355,105 @@ void RRMaximizer::do_step(const DoubleVector &step) {
     }
 }
 
+/** Optimal angle of a 2x2 rotation between orbitals p and q
+ *
+ * With i' = cos(t) i + sin(t) j and j' = -sin(t) i + cos(t) j, the pair
+ * contribution to the functional is const + P cos(4t) + Q sin(4t), where
+ * P = sum_d (u^2 - r_pq^2), Q = sum_d 2 u r_pq and u = (r_pp - r_qq)/2.
+ * Its maximum is at 4t = atan2(Q, P).
+ */
+double RRMaximizer::calcJacobiAngle(int p, int q) const {
+    double P = 0.0, Q = 0.0;
+    for (int d = 0; d < 3; d++) {
+        double r_pq = this->r_i(p, q + d * this->N);
+        double u = 0.5 * (this->r_i(p, p + d * this->N) - this->r_i(q, q + d * this->N));
+        P += u * u - r_pq * r_pq;
+        Q += 2.0 * u * r_pq;
+    }
+    if (std::abs(Q) < 1.0e-14 and P >= 0.0) return 0.0;
+    return 0.25 * std::atan2(Q, P);
+}
+
+/** Maximize the functional by Jacobi sweeps over 2x2 rotations
+ *
+ * @param max_sweeps: maximum number of sweeps over all orbital pairs
+ * @param thrs: convergence threshold for the largest rotation angle in a sweep
+ *
+ * Each sweep visits all orbital pairs in N-1 rounds of a round-robin tournament,
+ * where the N/2 pairs of a round are disjoint. The rotations of a round commute,
+ * so their angles are computed from the same matrices and they are applied with
+ * one OpenMP thread per pair: first to the rows, then to the columns of the
+ * position matrices. Neither the gradient nor the Hessian is stored, and a sweep
+ * costs O(N^3) time and no extra memory. Returns the number of sweeps, or -1 if
+ * not converged.
+ */
+int RRMaximizer::maximizeJacobi(int max_sweeps, double thrs) {
+    int M = this->N + (this->N % 2); // pad with a dummy orbital if odd
+    std::vector<int> pos(M);
+    std::iota(pos.begin(), pos.end(), 0);
+
+    int n_pairs = M / 2;
+    std::vector<std::pair<int, int>> pairs(n_pairs);
+    std::vector<double> cos_t(n_pairs), sin_t(n_pairs);
+
+    for (int sweep = 1; sweep <= max_sweeps; sweep++) {
+        double max_angle = 0.0;
+        for (int round = 0; round < M - 1; round++) {
+            for (int k = 0; k < n_pairs; k++) {
+                int p = pos[k];
+                int q = pos[M - 1 - k];
+                pairs[k] = {std::min(p, q), std::max(p, q)};
+                double t = (q < this->N and p < this->N) ? calcJacobiAngle(pairs[k].first, pairs[k].second) : 0.0;
+                max_angle = std::max(max_angle, std::abs(t));
+                cos_t[k] = std::cos(t);
+                sin_t[k] = std::sin(t);
+            }
+
+            // R <- G^T R: rows p and q of all three blocks
+#pragma omp parallel for schedule(static)
+            for (int k = 0; k < n_pairs; k++) {
+                if (sin_t[k] == 0.0) continue;
+                int p = pairs[k].first, q = pairs[k].second;
+                double c = cos_t[k], s = sin_t[k];
+                for (int col = 0; col < 3 * this->N; col++) {
+                    double r_p = this->r_i(p, col);
+                    double r_q = this->r_i(q, col);
+                    this->r_i(p, col) = c * r_p + s * r_q;
+                    this->r_i(q, col) = -s * r_p + c * r_q;
+                }
+            }
+            // R <- R G and U <- U G: columns p and q
+#pragma omp parallel for schedule(static)
+            for (int k = 0; k < n_pairs; k++) {
+                if (sin_t[k] == 0.0) continue;
+                int p = pairs[k].first, q = pairs[k].second;
+                double c = cos_t[k], s = sin_t[k];
+                for (int d = 0; d < 3; d++) {
+                    auto col_p = this->r_i.col(p + d * this->N);
+                    auto col_q = this->r_i.col(q + d * this->N);
+                    for (int row = 0; row < this->N; row++) {
+                        double r_p = col_p(row);
+                        double r_q = col_q(row);
+                        col_p(row) = c * r_p + s * r_q;
+                        col_q(row) = -s * r_p + c * r_q;
+                    }
+                }
+                auto u_p = this->total_U.col(p);
+                auto u_q = this->total_U.col(q);
+                for (int row = 0; row < this->N; row++) {
+                    double x_p = u_p(row);
+                    double x_q = u_q(row);
+                    u_p(row) = c * x_p + s * x_q;
+                    u_q(row) = -s * x_p + c * x_q;
+                }
+            }
+
+            // next round: keep pos[0] fixed and rotate the others
+            std::rotate(pos.begin() + 1, pos.end() - 1, pos.end());
+        }
+        if (max_angle < thrs) return sweep;
+    }
+    return -1;
+}
+
 } // namespace mrchem
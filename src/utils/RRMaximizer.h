@@ -41,9 +41,11 @@ namespace mrchem {
 class RRMaximizer final : public NonlinearMaximizer {
 public:
     RRMaximizer(double prec, OrbitalVector &Phi);
+    RRMaximizer(const DoubleMatrix &R_x, const DoubleMatrix &R_y, const DoubleMatrix &R_z);
     const DoubleMatrix &getTotalU() const { return this->total_U; }
     double get_hessian(int i, int j) override;
     void multiply_hessian(DoubleVector &vec, DoubleVector &Hv) override;
+    int maximizeJacobi(int max_sweeps = 200, double thrs = 1.0e-10);
 
 protected:
     int N;                 // number of orbitals
@@ -55,6 +57,7 @@ protected:
     double make_gradient() override;
     double make_hessian() override;
     void do_step(const DoubleVector &step) override;
+    double calcJacobiAngle(int p, int q) const;
 };
 
 } // namespace mrchem
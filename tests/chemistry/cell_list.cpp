@@ -0,0 +1,80 @@
+/*
+ * MRChem, a numerical real-space code for molecular electronic structure
+ * calculations within the self-consistent field (SCF) approximations of quantum
+ * chemistry (Hartree-Fock and Density Functional Theory).
+ * Copyright (C) 2023 Stig Rune Jensen, Luca Frediani, Peter Wind and contributors.
+ *
+ * This file is part of MRChem.
+ *
+ * MRChem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * MRChem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MRChem.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For information on the complete list of contributors to MRChem, see:
+ * <https://mrchem.readthedocs.io/>
+ */
+
+#include "catch2/catch_all.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#include "mrchem.h"
+
+#include "chemistry/CellList.h"
+#include "utils/math_utils.h"
+
+using namespace mrchem;
+
+namespace cell_list {
+
+TEST_CASE("CellList", "[cell_list]") {
+    // irregular cluster, with one point far away from the rest
+    std::vector<mrcpp::Coord<3>> coords;
+    for (int i = 0; i < 5; i++) {
+        for (int j = 0; j < 5; j++) {
+            for (int k = 0; k < 4; k++) coords.push_back({2.1 * i + 0.3 * j, 1.9 * j - 0.2 * k, 2.3 * k + 0.1 * i * i});
+        }
+    }
+    coords.push_back({40.0, -15.0, 3.0});
+    CellList cells(coords, 2.0);
+    REQUIRE(cells.size() == coords.size());
+
+    std::vector<mrcpp::Coord<3>> points = {{0.0, 0.0, 0.0}, {4.4, 3.1, 5.2}, {-10.0, 2.0, 30.0}, {35.0, -10.0, 0.0}};
+    for (int p = 0; p < coords.size() + points.size(); p++) {
+        auto r = (p < coords.size()) ? coords[p] : points[p - coords.size()];
+        int exclude = (p < coords.size()) ? p : -1;
+
+        // nearest neighbour, compared to brute force
+        int ref = -1;
+        for (int n = 0; n < coords.size(); n++) {
+            if (n == exclude) continue;
+            if (ref < 0 or math_utils::calc_distance(coords[n], r) < math_utils::calc_distance(coords[ref], r)) ref = n;
+        }
+        int nearest = cells.getNearest(r, exclude);
+        REQUIRE(nearest >= 0);
+        REQUIRE(math_utils::calc_distance(coords[nearest], r) == Catch::Approx(math_utils::calc_distance(coords[ref], r)));
+
+        // points within radius, compared to brute force
+        for (double radius : {0.5, 2.5, 7.0}) {
+            std::vector<int> ref_list;
+            for (int n = 0; n < coords.size(); n++) {
+                if (math_utils::calc_distance(coords[n], r) <= radius) ref_list.push_back(n);
+            }
+            auto neighbours = cells.getNeighbours(r, radius);
+            std::sort(neighbours.begin(), neighbours.end());
+            REQUIRE(neighbours == ref_list);
+        }
+    }
+}
+
+} // namespace cell_list
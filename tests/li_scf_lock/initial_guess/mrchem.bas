@@ -0,0 +1,15 @@
+Gaussian basis 3-21G
+        1
+        3.    1    2    1    1
+Li        0.0000000000       0.0000000000       0.0000000000
+        6    3
+    36.83820000  0.06966860  0.00000000  0.00000000
+     5.48172000  0.38134600  0.00000000  0.00000000
+     1.11327000  0.68170200  0.00000000  0.00000000
+     0.54020500  0.00000000 -0.26312700  0.00000000
+     0.10225500  0.00000000  1.14339000  0.00000000
+     0.02856500  0.00000000  0.00000000  1.00000000
+        3    2
+     0.54020500  0.16154600  0.00000000
+     0.10225500  0.91566300  0.00000000
+     0.02856500  0.00000000  1.00000000
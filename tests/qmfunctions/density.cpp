@@ -79,6 +79,62 @@ TEST_CASE("Density", "[density]") {
             REQUIRE(rho_a.integrate().real() == Catch::Approx(5.0));
             REQUIRE(rho_b.integrate().real() == Catch::Approx(2.0));
         }
+
+        SECTION("single pass total/spin/alpha/beta density") {
+            Density rho_t(false);
+            Density rho_s(false);
+            Density rho_a(false);
+            Density rho_b(false);
+
+            std::vector<Density *> rho = {&rho_t, &rho_s, &rho_a, &rho_b};
+            std::vector<DensityType> spin = {DensityType::Total, DensityType::Spin, DensityType::Alpha, DensityType::Beta};
+            density::compute(prec, rho, Phi, spin);
+
+            REQUIRE(rho_t.integrate().real() == Catch::Approx(7.0));
+            REQUIRE(rho_s.integrate().real() == Catch::Approx(3.0));
+            REQUIRE(rho_a.integrate().real() == Catch::Approx(5.0));
+            REQUIRE(rho_b.integrate().real() == Catch::Approx(2.0));
+        }
+
+        SECTION("node reduction total density") {
+            Density rho_ref(false);
+            Density rho_nod(false);
+            density::compute(prec, rho_ref, Phi, DensityType::Total);
+
+            density::reduce_by_nodes = true;
+            density::compute(prec, rho_nod, Phi, DensityType::Total);
+            density::reduce_by_nodes = false;
+
+            Density rho_diff(false);
+            mrcpp::cplxfunc::add(rho_diff, 1.0, rho_nod, -1.0, rho_ref, -1.0);
+            REQUIRE(rho_nod.integrate().real() == Catch::Approx(rho_ref.integrate().real()));
+            REQUIRE(rho_diff.norm() < prec);
+        }
+
+        SECTION("node reduction alpha/beta density") {
+            Density rho_a(false);
+            Density rho_b(false);
+            Density rho_a_nod(false);
+            Density rho_b_nod(false);
+            std::vector<DensityType> spin = {DensityType::Alpha, DensityType::Beta};
+
+            std::vector<Density *> rho = {&rho_a, &rho_b};
+            density::compute(prec, rho, Phi, spin);
+
+            density::reduce_by_nodes = true;
+            std::vector<Density *> rho_nod = {&rho_a_nod, &rho_b_nod};
+            density::compute(prec, rho_nod, Phi, spin);
+            density::reduce_by_nodes = false;
+
+            Density diff_a(false);
+            Density diff_b(false);
+            mrcpp::cplxfunc::add(diff_a, 1.0, rho_a_nod, -1.0, rho_a, -1.0);
+            mrcpp::cplxfunc::add(diff_b, 1.0, rho_b_nod, -1.0, rho_b, -1.0);
+            REQUIRE(rho_a_nod.integrate().real() == Catch::Approx(5.0));
+            REQUIRE(rho_b_nod.integrate().real() == Catch::Approx(2.0));
+            REQUIRE(diff_a.norm() < prec);
+            REQUIRE(diff_b.norm() < prec);
+        }
     }
 }
 
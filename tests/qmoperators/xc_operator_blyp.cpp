@@ -118,6 +118,23 @@ TEST_CASE("XCOperatorBLYP", "[xc_operator_blyp]") {
             }
         }
     }
+    SECTION("vector apply one thread per orbital") {
+        OrbitalVector VPhi_ref = V(Phi);
+
+        // Any orbital size qualifies, so the threaded path is taken with > 1 thread
+        int omp_nodes = RankZeroOperator::omp_orbital_nodes;
+        RankZeroOperator::omp_orbital_nodes = 1000000;
+        OrbitalVector VPhi = V(Phi);
+        RankZeroOperator::omp_orbital_nodes = omp_nodes;
+
+        for (int i = 0; i < Phi.size(); i++) {
+            if (not mrcpp::mpi::my_orb(Phi[i])) continue;
+            Orbital diff = Phi[i].paramCopy();
+            mrcpp::cplxfunc::add(diff, 1.0, VPhi[i], -1.0, VPhi_ref[i], -1.0);
+            REQUIRE(diff.norm() < thrs);
+            REQUIRE(VPhi[i].norm() == Catch::Approx(VPhi_ref[i].norm()).epsilon(thrs));
+        }
+    }
     SECTION("expectation value") {
         ComplexDouble V_00 = V(Phi[0], Phi[0]);
         if (mrcpp::mpi::my_orb(Phi[0])) {
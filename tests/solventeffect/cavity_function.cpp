@@ -34,6 +34,7 @@
 #include "mrchem.h"
 
 #include "environment/Cavity.h"
+#include "utils/math_utils.h"
 
 using namespace mrchem;
 
@@ -78,4 +79,37 @@ TEST_CASE("Cavityfunction", "[cavity_function]") {
     double two_sphere_volume = two_cav_tree.integrate();
     REQUIRE(two_sphere_volume == Catch::Approx(7.5096630756284952213).epsilon(thrs * 10));
 }
+
+TEST_CASE("Cavity spatial index", "[cavity_function]") {
+    // cubic cluster of spheres, large enough that most spheres are screened
+    std::vector<mrcpp::Coord<3>> coords;
+    std::vector<double> R;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            for (int k = 0; k < 4; k++) {
+                coords.push_back({3.0 * i - 4.5, 3.0 * j - 4.5, 3.0 * k - 4.5});
+                R.push_back(1.0 + 0.1 * ((i + j + k) % 3));
+            }
+        }
+    }
+    double slope = 0.2;
+    Cavity cluster(coords, R, slope);
+
+    std::vector<mrcpp::Coord<3>> points = {{0.0, 0.0, 0.0}, {-4.5, -4.5, -3.4}, {1.2, -0.7, 2.9}, {6.0, 6.0, 6.0}, {-20.0, 0.5, 0.5}};
+    auto radii = cluster.getRadii();
+    auto widths = cluster.getWidths();
+    for (const auto &r : points) {
+        // brute force evaluation over all spheres
+        double C = 1.0;
+        for (int i = 0; i < coords.size(); i++) {
+            auto s = math_utils::calc_distance(coords[i], r) - radii[i];
+            C *= 0.5 * (1 + std::erf(s / widths[i]));
+        }
+        REQUIRE(cluster.evalf(r) == Catch::Approx(1.0 - C).margin(1.0e-14));
+        for (int d = 0; d < 3; d++) {
+            double ref = detail::gradCavity(r, d, coords, radii, widths);
+            REQUIRE(cluster.evalGradient(r, d) == Catch::Approx(ref).margin(1.0e-9));
+        }
+    }
+}
 } // namespace cavity_function
@@ -0,0 +1,126 @@
+/*
+ * MRChem, a numerical real-space code for molecular electronic structure
+ * calculations within the self-consistent field (SCF) approximations of quantum
+ * chemistry (Hartree-Fock and Density Functional Theory).
+ * Copyright (C) 2023 Stig Rune Jensen, Luca Frediani, Peter Wind and contributors.
+ *
+ * This file is part of MRChem.
+ *
+ * MRChem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * MRChem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MRChem.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For information on the complete list of contributors to MRChem, see:
+ * <https://mrchem.readthedocs.io/>
+ */
+
+#include "catch2/catch_all.hpp"
+
+#include <cmath>
+#include <vector>
+
+#include "utils/PolyInterpolator.h"
+
+using namespace interpolation_utils;
+
+namespace poly_interpolator {
+
+// Reference evaluation as done before the interval polynomials were
+// precomputed: binary search for the interval and a Newton-form polynomial
+// through the five surrounding grid points
+double reference_eval(const Eigen::VectorXd &x, const Eigen::VectorXd &y, double xval) {
+    int n = x.size();
+    int i = binarySearch(x, xval);
+    if (i < 2) i = 2;
+    if (i > n - 3) i = n - 3;
+    Eigen::VectorXd x_poly = x.segment(i - 2, 5);
+    Eigen::VectorXd y_poly = y.segment(i - 2, 5);
+    return polynomialInterpolate5(x_poly, y_poly, xval);
+}
+
+// Grid nodes, interval midpoints, points next to the nodes and a point left of xmin
+std::vector<double> test_points(const Eigen::VectorXd &x) {
+    std::vector<double> points;
+    int n = x.size();
+    for (int i = 0; i < n - 1; i++) {
+        double h = x(i + 1) - x(i);
+        points.push_back(x(i));
+        points.push_back(x(i) + 1.0e-9 * h);
+        points.push_back(x(i) + 0.5 * h);
+        points.push_back(x(i + 1) - 1.0e-9 * h);
+    }
+    points.push_back(x(n - 1));
+    points.push_back(x(0) - 0.5 * (x(1) - x(0)));
+    return points;
+}
+
+void compare_to_reference(const Eigen::VectorXd &x, const Eigen::VectorXd &y) {
+    PolyInterpolator interp(x, y);
+    auto points = test_points(x);
+    for (auto xval : points) {
+        double ref = reference_eval(x, y, xval);
+        REQUIRE(interp.evalfLeftNoRightConstant(xval) == Catch::Approx(ref).epsilon(1.0e-10).margin(1.0e-12));
+    }
+
+    // batched evaluation must agree with the pointwise one
+    Eigen::VectorXd xvals = Eigen::Map<Eigen::VectorXd>(points.data(), points.size());
+    Eigen::VectorXd yvals(xvals.size());
+    interp.evalfLeftNoRightZero(xvals, yvals);
+    for (int k = 0; k < xvals.size(); k++) REQUIRE(yvals(k) == interp.evalfLeftNoRightZero(xvals(k)));
+
+    // right extrapolation
+    double x_out = x(x.size() - 1) + 1.0;
+    REQUIRE(interp.evalfLeftNoRightZero(x_out) == 0.0);
+    REQUIRE(interp.evalfLeftNoRightConstant(x_out) == y(y.size() - 1));
+    Eigen::VectorXd x_poly = x.tail(5);
+    Eigen::VectorXd y_poly = y.tail(5);
+    double yp_ref = polynomialInterpolate5_deriv(x_poly, y_poly, x(x.size() - 1));
+    double y_ref = y(y.size() - 1) + yp_ref * (x_out - x(x.size() - 1));
+    REQUIRE(interp.evalfLeftNoRightLinear(x_out) == Catch::Approx(y_ref).epsilon(1.0e-10));
+}
+
+TEST_CASE("PolyInterpolator", "[poly_interpolator]") {
+    SECTION("uniform grid") {
+        int n = 40;
+        Eigen::VectorXd x(n), y(n);
+        for (int i = 0; i < n; i++) {
+            x(i) = 0.25 * i;
+            y(i) = std::sin(x(i)) + 0.1 * x(i);
+        }
+        compare_to_reference(x, y);
+    }
+    SECTION("exponential radial grid") {
+        int n = 200;
+        Eigen::VectorXd x(n), y(n);
+        for (int i = 0; i < n; i++) {
+            x(i) = 1.0e-6 * std::exp(0.1 * i);
+            y(i) = std::log(std::exp(-2.0 * x(i)) + 1.0e-3 * std::exp(-0.5 * x(i)));
+        }
+        compare_to_reference(x, y);
+    }
+    SECTION("irregular grid") {
+        int n = 23;
+        Eigen::VectorXd x(n), y(n);
+        x(0) = -3.0;
+        for (int i = 1; i < n; i++) x(i) = x(i - 1) + 0.05 + 0.4 * std::abs(std::sin(1.7 * i));
+        for (int i = 0; i < n; i++) y(i) = std::exp(-x(i) * x(i)) * std::cos(3.0 * x(i));
+        compare_to_reference(x, y);
+    }
+    SECTION("minimal grid") {
+        Eigen::VectorXd x(5), y(5);
+        x << 0.0, 0.1, 0.5, 0.6, 2.0;
+        y << 1.0, -1.0, 2.0, 0.5, 3.0;
+        compare_to_reference(x, y);
+    }
+}
+
+} // namespace poly_interpolator
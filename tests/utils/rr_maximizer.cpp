@@ -0,0 +1,105 @@
+/*
+ * MRChem, a numerical real-space code for molecular electronic structure
+ * calculations within the self-consistent field (SCF) approximations of quantum
+ * chemistry (Hartree-Fock and Density Functional Theory).
+ * Copyright (C) 2023 Stig Rune Jensen, Luca Frediani, Peter Wind and contributors.
+ *
+ * This file is part of MRChem.
+ *
+ * MRChem is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * MRChem is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with MRChem.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ * For information on the complete list of contributors to MRChem, see:
+ * <https://mrchem.readthedocs.io/>
+ */
+
+#include "catch2/catch_all.hpp"
+
+#include <cmath>
+
+#include <unsupported/Eigen/MatrixFunctions>
+
+#include "mrchem.h"
+
+#include "utils/RRMaximizer.h"
+
+using namespace mrchem;
+
+namespace rr_maximizer {
+
+// Foster-Boys functional sum_d sum_i (U^T R_d U)_ii^2 of the rotated orbitals
+double calc_functional(const DoubleMatrix &U, const DoubleMatrix (&R)[3]) {
+    double f = 0.0;
+    for (int d = 0; d < 3; d++) f += (U.transpose() * R[d] * U).diagonal().squaredNorm();
+    return f;
+}
+
+// Position matrices of N orbitals centered on a distorted lattice, mixed by a
+// rotation and with a small non-commuting perturbation
+void make_position_matrices(int N, DoubleMatrix (&R)[3]) {
+    DoubleMatrix A = DoubleMatrix::Zero(N, N);
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < i; j++) {
+            A(i, j) = 0.5 * std::sin(1.3 * i + 2.9 * j + 0.7);
+            A(j, i) = -A(i, j);
+        }
+    }
+    DoubleMatrix Q = A.exp();
+    for (int d = 0; d < 3; d++) {
+        DoubleMatrix X = DoubleMatrix::Zero(N, N);
+        DoubleMatrix E = DoubleMatrix::Zero(N, N);
+        for (int i = 0; i < N; i++) {
+            X(i, i) = 2.0 * ((i >> d) % 3) + 0.3 * std::cos(1.7 * i + d);
+            for (int j = 0; j <= i; j++) E(i, j) = E(j, i) = 0.01 * std::sin(0.9 * i * j + d);
+        }
+        R[d] = Q.transpose() * X * Q + E;
+    }
+}
+
+TEST_CASE("RRMaximizer", "[rr_maximizer]") {
+    for (int N : {7, 12}) {
+        DYNAMIC_SECTION("N = " << N) {
+            DoubleMatrix R[3];
+            make_position_matrices(N, R);
+            DoubleMatrix I = DoubleMatrix::Identity(N, N);
+            double f_0 = calc_functional(I, R);
+
+            RRMaximizer rr_newton(R[0], R[1], R[2]);
+            REQUIRE(rr_newton.maximize() > 0);
+            DoubleMatrix U_newton = rr_newton.getTotalU();
+
+            RRMaximizer rr_jacobi(R[0], R[1], R[2]);
+            REQUIRE(rr_jacobi.maximizeJacobi() > 0);
+            DoubleMatrix U_jacobi = rr_jacobi.getTotalU();
+
+            // both rotations are orthogonal
+            REQUIRE((U_newton.transpose() * U_newton - I).norm() < 1.0e-10);
+            REQUIRE((U_jacobi.transpose() * U_jacobi - I).norm() < 1.0e-10);
+
+            // and reach the same maximum
+            double f_newton = calc_functional(U_newton, R);
+            double f_jacobi = calc_functional(U_jacobi, R);
+            REQUIRE(f_jacobi > f_0);
+            REQUIRE(f_jacobi == Catch::Approx(f_newton).epsilon(1.0e-8));
+
+            // an already localized set is left unchanged
+            DoubleMatrix R_loc[3];
+            for (int d = 0; d < 3; d++) R_loc[d] = U_jacobi.transpose() * R[d] * U_jacobi;
+            RRMaximizer rr_loc(R_loc[0], R_loc[1], R_loc[2]);
+            REQUIRE(rr_loc.maximize() == 0);
+            REQUIRE((rr_loc.getTotalU() - I).norm() < 1.0e-10);
+        }
+    }
+}
+
+} // namespace rr_maximizer